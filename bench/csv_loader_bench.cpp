@@ -0,0 +1,94 @@
+// Ingest throughput of CsvLoader on a generated file with INTEGER, FLOAT,
+// VARCHAR (a quarter of them quoted, some with embedded delimiters and
+// escapes) and DATE columns, for 1 to --threads threads.
+//
+//   csv_loader_bench [--size-mb N] [--threads T] [--file PATH]
+//
+// The generated file is written to PATH (default: the temp directory) and
+// removed afterwards.
+
+#include "execution/csv_loader.h"
+#include "execution/parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+size_t writeCsv(const std::string& path, size_t target_bytes) {
+    std::ofstream out(path, std::ios::binary);
+    std::mt19937_64 rng(7);
+    std::string line;
+    size_t bytes = 0;
+    for (uint64_t row = 0; bytes < target_bytes; ++row) {
+        line = std::to_string(row) + ",";
+        line += std::to_string(static_cast<double>(rng() % 1000000) / 100.0) + ",";
+        if (row % 4 == 0) {
+            line += "\"customer, \"\"" + std::to_string(rng() % 100000) + "\"\"\",";
+        } else {
+            line += "customer_" + std::to_string(rng() % 100000) + ",";
+        }
+        line += "20" + std::to_string(10 + rng() % 15) + "-0" + std::to_string(1 + rng() % 9) +
+                "-1" + std::to_string(rng() % 10) + "\n";
+        out << line;
+        bytes += line.size();
+    }
+    return bytes;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t size_mb = 512;
+    size_t max_threads = resolveThreadCount(0);
+    std::string path = (std::filesystem::temp_directory_path() / "csv_loader_bench.csv").string();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--size-mb" && i + 1 < argc) size_mb = std::stoull(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) max_threads = std::stoull(argv[++i]);
+        else if (arg == "--file" && i + 1 < argc) path = argv[++i];
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+    
+    TableInfo table("orders", 0);
+    table.addColumn(ColumnInfo("id", DataType::INTEGER, 0));
+    table.addColumn(ColumnInfo("amount", DataType::FLOAT, 1));
+    table.addColumn(ColumnInfo("customer", DataType::VARCHAR, 2));
+    table.addColumn(ColumnInfo("ordered", DataType::DATE, 3));
+    
+    size_t bytes = writeCsv(path, size_mb * 1024 * 1024);
+    std::cout << "file " << path << ": " << bytes / (1024 * 1024) << " MiB\n";
+    std::cout << std::setw(10) << "threads" << std::setw(12) << "rows"
+              << std::setw(12) << "load_ms" << std::setw(10) << "GB/s"
+              << std::setw(12) << "Mrows/s" << "\n";
+    
+    for (size_t threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        CsvOptions options;
+        options.num_threads = threads;
+        TableData data(table);
+        auto start = std::chrono::steady_clock::now();
+        size_t rows = CsvLoader(table, options).loadFile(path, data);
+        double seconds = secondsSince(start);
+        
+        std::cout << std::setw(10) << threads << std::setw(12) << rows
+                  << std::setw(12) << std::fixed << std::setprecision(2) << seconds * 1e3
+                  << std::setw(10) << static_cast<double>(bytes) / seconds / 1e9
+                  << std::setw(12) << static_cast<double>(rows) / seconds / 1e6 << "\n";
+        if (threads == max_threads) break;
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Build/probe throughput of HashJoin for build and probe sides of 1K to
+// 100M rows. Most probe keys have no partner, so the Bloom filter has work
+// to do.
+//
+//   hash_join_bench [--max-rows N] [--threads T] [--no-bloom]
+
+#include "execution/hash_join.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+ColumnData randomKeys(size_t rows, uint64_t key_range, uint64_t seed) {
+    ColumnData keys(DataType::INTEGER);
+    keys.reserve(rows);
+    std::mt19937_64 rng(seed);
+    for (size_t i = 0; i < rows; ++i) {
+        keys.appendInteger(static_cast<int64_t>(rng() % key_range));
+    }
+    return keys;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t max_rows = 100'000'000;
+    JoinOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--max-rows" && i + 1 < argc) max_rows = std::stoull(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) options.num_threads = std::stoull(argv[++i]);
+        else if (arg == "--no-bloom") options.use_bloom_filter = false;
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+    
+    std::cout << std::setw(12) << "build_rows" << std::setw(12) << "probe_rows"
+              << std::setw(12) << "partitions" << std::setw(12) << "build_ms"
+              << std::setw(14) << "build_Mrows/s" << std::setw(12) << "probe_ms"
+              << std::setw(14) << "probe_Mrows/s" << std::setw(12) << "matches"
+              << std::setw(12) << "filtered" << "\n";
+    
+    for (size_t rows = 1000; rows <= max_rows; rows *= 10) {
+        // Build keys are drawn from [0, 2 * rows) and probe keys from twice
+        // that range, so about three quarters of the probes miss.
+        ColumnData build_keys = randomKeys(rows, 2 * rows, 1);
+        ColumnData probe_keys = randomKeys(rows, 4 * rows, 2);
+        
+        HashJoin join(options);
+        auto start = std::chrono::steady_clock::now();
+        join.build(build_keys);
+        double build_seconds = secondsSince(start);
+        
+        std::atomic<uint64_t> matches{0};
+        start = std::chrono::steady_clock::now();
+        join.probe(probe_keys, [&](const JoinBatch& batch) { matches += batch.size(); });
+        double probe_seconds = secondsSince(start);
+        
+        std::cout << std::setw(12) << rows << std::setw(12) << rows
+                  << std::setw(12) << join.partitionCount()
+                  << std::setw(12) << std::fixed << std::setprecision(2) << build_seconds * 1e3
+                  << std::setw(14) << static_cast<double>(rows) / build_seconds / 1e6
+                  << std::setw(12) << probe_seconds * 1e3
+                  << std::setw(14) << static_cast<double>(rows) / probe_seconds / 1e6
+                  << std::setw(12) << matches.load()
+                  << std::setw(12) << join.filteredProbeRows() << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+// INSERT throughput through the write-ahead log for 1 to --max-writers
+// concurrent writers. Every insert converts a parsed single-row INSERT with
+// buildInsertBatch, waits for WriteAheadLog::append to make it durable and
+// then applies it to the in-memory table, so the fdatasync cost is shared
+// only through group commit.
+//
+//   wal_bench [--max-writers N] [--seconds S] [--delay-us D] [--batch B]
+//             [--no-sync] [--dir PATH]
+
+#include "parser/lexer.h"
+#include "parser/parser.h"
+#include "storage/insert_batch.h"
+#include "storage/wal.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    size_t max_writers = 64;
+    double seconds = 2.0;
+    WalOptions options;
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--max-writers" && i + 1 < argc) max_writers = std::stoull(argv[++i]);
+        else if (arg == "--seconds" && i + 1 < argc) seconds = std::stod(argv[++i]);
+        else if (arg == "--delay-us" && i + 1 < argc) options.max_commit_delay = std::chrono::microseconds(std::stoll(argv[++i]));
+        else if (arg == "--batch" && i + 1 < argc) options.max_batch_records = std::stoull(argv[++i]);
+        else if (arg == "--no-sync") options.sync = false;
+        else if (arg == "--dir" && i + 1 < argc) dir = argv[++i];
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+    
+    TableInfo table("events", 0);
+    table.addColumn(ColumnInfo("id", DataType::INTEGER, 0));
+    table.addColumn(ColumnInfo("kind", DataType::VARCHAR, 1));
+    table.addColumn(ColumnInfo("value", DataType::FLOAT, 2));
+    Lexer lexer("INSERT INTO events VALUES (42, 'click', 0.5)");
+    Parser parser(lexer.tokenize());
+    std::unique_ptr<Statement> stmt = parser.parse();
+    const auto* insert = dynamic_cast<const InsertStatement*>(stmt.get());
+    
+    std::cout << std::setw(10) << "writers" << std::setw(12) << "inserts"
+              << std::setw(14) << "inserts/s" << std::setw(12) << "commits"
+              << std::setw(14) << "rows/commit" << std::setw(14) << "avg_lat_us" << "\n";
+    
+    for (size_t writers = 1;; writers = std::min(writers * 2, max_writers)) {
+        const std::string path = (dir / "wal_bench.log").string();
+        std::filesystem::remove(path);
+        TableData data(table);
+        std::mutex data_mutex;
+        std::atomic<uint64_t> inserts{0};
+        uint64_t commits;
+        double elapsed;
+        {
+            WriteAheadLog wal(path, options);
+            const auto start = std::chrono::steady_clock::now();
+            const auto deadline = start + std::chrono::duration<double>(seconds);
+            std::vector<std::thread> threads;
+            for (size_t w = 0; w < writers; ++w) {
+                threads.emplace_back([&] {
+                    uint64_t done = 0;
+                    while (std::chrono::steady_clock::now() < deadline) {
+                        TableData rows = buildInsertBatch(table, {insert});
+                        wal.append(table.table_id, rows);
+                        std::lock_guard<std::mutex> lock(data_mutex);
+                        data.append(rows);
+                        done++;
+                    }
+                    inserts += done;
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            commits = wal.commitCount();
+        }
+        std::filesystem::remove(path);
+        
+        const double total = static_cast<double>(inserts.load());
+        std::cout << std::setw(10) << writers << std::setw(12) << inserts.load()
+                  << std::setw(14) << std::fixed << std::setprecision(0) << total / elapsed
+                  << std::setw(12) << commits
+                  << std::setw(14) << std::setprecision(1) << total / std::max<uint64_t>(1, commits)
+                  << std::setw(14) << elapsed * static_cast<double>(writers) / total * 1e6 << "\n";
+        if (writers == max_writers) break;
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+#ifndef BINDER_H
+#define BINDER_H
+
+#include "binder/catalog.h"
+#include "binder/types.h"
+#include "parser/ast.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct AggregateSpec {
+    AggregateExpression::Function function;
+    bool has_argument;         // false for COUNT(*)
+    size_t column_id;          // input column when has_argument
+    DataType input_type;
+    DataType result_type;
+};
+
+// Resolved form of `SELECT ... FROM t GROUP BY ...` with aggregates.
+struct AggregatePlan {
+    // Either a GROUP BY key (index into group_columns) or an aggregate
+    // (index into aggregates), in select-list order.
+    struct OutputColumn {
+        bool is_aggregate;
+        size_t index;
+        std::string name;
+        DataType type;
+    };
+
+    const TableInfo* table;
+    std::vector<size_t> group_columns;
+    std::vector<AggregateSpec> aggregates;
+    std::vector<OutputColumn> outputs;
+};
+
+// Resolved form of `SELECT ... FROM left JOIN right ON left.a = right.b`.
+struct JoinPlan {
+    // A selected column of either table, in select-list order; `*` expands
+    // to the columns of the left table, then the right one.
+    struct OutputColumn {
+        bool from_right;
+        size_t column_id;
+        std::string name;
+        DataType type;
+    };
+
+    const TableInfo* left_table;
+    const TableInfo* right_table;
+    size_t left_key;     // column id in left_table
+    size_t right_key;    // column id in right_table
+    DataType key_type;
+    std::vector<OutputColumn> outputs;
+};
+
+struct SortKey {
+    size_t column_id;
+    DataType type;
+    bool descending;
+};
+
+// Resolved form of `SELECT ... FROM t ORDER BY ... [LIMIT n]`.
+struct SortPlan {
+    // A selected column in select-list order; `*` expands to every column.
+    struct OutputColumn {
+        size_t column_id;
+        std::string name;
+        DataType type;
+    };
+
+    const TableInfo* table;
+    std::vector<SortKey> keys;
+    std::optional<size_t> limit;
+    std::vector<OutputColumn> outputs;
+};
+
+// Resolved form of `COPY t FROM 'path'`.
+struct CopyPlan {
+    const TableInfo* table;
+    std::string file_path;
+};
+
+// Result type of an aggregate over `input`; throws std::runtime_error if the
+// function cannot be applied to that type.
+DataType aggregateResultType(AggregateExpression::Function function, DataType input);
+
+// Name resolution and type checking against a catalog. Errors are reported
+// by throwing std::runtime_error.
+class Binder {
+public:
+    explicit Binder(const Catalog& catalog);
+
+    AggregatePlan bindAggregate(const SelectStatement& stmt) const;
+    // Binds a single inner equi-join that selects plain columns.
+    JoinPlan bindJoin(const SelectStatement& stmt) const;
+    SortPlan bindSort(const SelectStatement& stmt) const;
+    CopyPlan bindCopy(const CopyStatement& stmt) const;
+
+    static bool hasAggregates(const SelectStatement& stmt);
+
+private:
+    const Catalog& catalog;
+
+    const TableInfo& resolveTable(const std::string& name) const;
+    const ColumnInfo& resolveColumn(const TableInfo& table, const Expression& expr) const;
+    // Resolves a possibly qualified column against several tables; returns
+    // the index of the owning table.
+    size_t resolveColumn(const std::vector<const TableInfo*>& tables, const Expression& expr,
+                         const ColumnInfo*& column) const;
+};
+
+#endif
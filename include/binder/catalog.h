@@ -1,8 +1,15 @@
+#ifndef CATALOG_H
+#define CATALOG_H
 
 #include "binder/types.h"
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
+
+// Table and column names are matched case-insensitively.
+bool equalsIgnoreCase(const std::string& a, const std::string& b);
+
 struct ColumnInfo{
   std::string name;
   DataType type;
@@ -26,4 +33,19 @@ class TableInfo{
     const ColumnInfo* getColumn(const std::string& col_name)const;
 
     
-};
\ No newline at end of file
+};
+
+class Catalog{
+  public:
+    // Throws std::runtime_error if a table with this name already exists.
+    TableInfo* createTable(const std::string& name);
+
+    TableInfo* getTable(const std::string& name);
+    const TableInfo* getTable(const std::string& name) const;
+    const TableInfo* getTableById(size_t table_id) const;
+
+  private:
+    std::vector<std::unique_ptr<TableInfo>> tables;
+};
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Front-end instrumentation. Hot paths only go through the DB_STATS_* macros
+// below, which compile to nothing unless DB_ENABLE_STATS is defined
+// (CMake option ENABLE_STATS).
+
+enum class Phase {
+    LEX,
+    PARSE,
+    BIND,
+    NUM_PHASES
+};
+
+enum class Counter {
+    TOKENS,
+    AST_NODES,
+    STATEMENTS,
+    NUM_COUNTERS
+};
+
+std::string phaseToString(Phase phase);
+std::string counterToString(Counter counter);
+
+// Log-linear (HDR-style) histogram: every power of two is split into
+// SUB_BUCKETS linear buckets, so recorded values keep ~6% relative precision
+// over the full uint64_t range. Recording is lock-free.
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 4;
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    LatencyHistogram();
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t count() const;
+    uint64_t sum() const;
+    uint64_t min() const;
+    uint64_t max() const;
+    // Upper bound of the bucket holding the p-th percentile, p in [0, 100].
+    uint64_t percentile(double p) const;
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets;
+    std::atomic<uint64_t> total_count;
+    std::atomic<uint64_t> total_sum;
+    std::atomic<uint64_t> min_value;
+    std::atomic<uint64_t> max_value;
+};
+
+struct PhaseStats {
+    LatencyHistogram latency;
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> bytes_allocated{0};
+    std::atomic<uint64_t> allocations{0};
+};
+
+class Stats {
+public:
+    static Stats& instance();
+
+    void recordPhase(Phase phase, uint64_t nanos, uint64_t bytes, uint64_t allocs);
+    void addCounter(Counter counter, uint64_t amount);
+
+    const PhaseStats& phase(Phase phase) const;
+    uint64_t counter(Counter counter) const;
+
+    std::string toJson() const;
+    std::string toPrometheus() const;
+    void reset();
+
+private:
+    Stats() = default;
+
+    std::array<PhaseStats, static_cast<size_t>(Phase::NUM_PHASES)> phases;
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::NUM_COUNTERS)> counters{};
+};
+
+// Bytes and allocation calls made through global operator new on the calling
+// thread. Only maintained when DB_ENABLE_STATS is defined; zero otherwise.
+uint64_t threadAllocatedBytes();
+uint64_t threadAllocationCount();
+
+// Records wall time and allocations between construction and destruction
+// against a phase.
+class ScopedPhaseTimer {
+public:
+    explicit ScopedPhaseTimer(Phase p);
+    ~ScopedPhaseTimer();
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    Phase phase;
+    std::chrono::steady_clock::time_point start;
+    uint64_t start_bytes;
+    uint64_t start_allocs;
+};
+
+#define DB_STATS_CONCAT_INNER(a, b) a##b
+#define DB_STATS_CONCAT(a, b) DB_STATS_CONCAT_INNER(a, b)
+
+#ifdef DB_ENABLE_STATS
+#define DB_STATS_PHASE(phase) \
+    ScopedPhaseTimer DB_STATS_CONCAT(stats_phase_timer_, __LINE__)(phase)
+#define DB_STATS_ADD(counter, amount) \
+    Stats::instance().addCounter((counter), (amount))
+#else
+#define DB_STATS_PHASE(phase) ((void)0)
+#define DB_STATS_ADD(counter, amount) ((void)0)
+#endif
+
+#endif
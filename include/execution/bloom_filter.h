@@ -0,0 +1,31 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Register-blocked Bloom filter: each key sets PROBES bits inside a single
+// 64-bit word, so a lookup costs one cache miss. Inserts are thread-safe;
+// lookups must not race with inserts.
+class BloomFilter {
+public:
+    static constexpr size_t PROBES = 4;
+
+    BloomFilter(size_t expected_keys, size_t bits_per_key = 16);
+
+    void insert(uint64_t hash);
+    bool mayContain(uint64_t hash) const;
+
+    size_t sizeInBytes() const;
+
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+    size_t num_words;
+    uint64_t word_mask;
+
+    static uint64_t wordPattern(uint64_t hash);
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef CSV_LOADER_H
+#define CSV_LOADER_H
+
+#include "binder/catalog.h"
+#include "storage/column_data.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+struct CsvOptions {
+    size_t num_threads = 0;              // 0 = hardware concurrency
+    char delimiter = ',';
+    bool header = false;                 // skip the first record
+    size_t chunk_bytes = 1024 * 1024;    // unit of work handed to a thread
+};
+
+// Bulk loader behind COPY ... FROM. Fields follow RFC 4180: double-quoted
+// fields may contain delimiters, newlines and "" escapes; lines end in \n or
+// \r\n, and blank lines are skipped. Values are converted straight into the
+// table's column types (INTEGER/FLOAT with std::from_chars, BOOLEAN as
+// true/false/t/f/1/0, DATE as YYYY-MM-DD). Empty unquoted fields are only
+// allowed for VARCHAR columns.
+//
+// The input is cut into chunk_bytes pieces. A first parallel pass counts the
+// quotes in each piece so every piece knows whether it starts inside a quoted
+// field; each piece is then moved forward to the first record boundary and
+// parsed into its own batch. Batches are appended to the target in file
+// order only once all of them parsed, so a malformed file leaves the target
+// untouched.
+class CsvLoader {
+public:
+    explicit CsvLoader(const TableInfo& table, CsvOptions options = {});
+
+    // Maps the file and appends its rows to `target`; returns the row count.
+    size_t loadFile(const std::string& path, TableData& target) const;
+    // Same, for CSV text already in memory.
+    size_t load(std::string_view text, TableData& target) const;
+
+private:
+    const TableInfo& table;
+    CsvOptions options;
+
+    TableData parseChunk(std::string_view text, size_t begin, size_t end) const;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef HASH_AGGREGATE_H
+#define HASH_AGGREGATE_H
+
+#include "binder/binder.h"
+#include "storage/column_data.h"
+#include <cstddef>
+
+struct AggregateOptions {
+    size_t num_threads = 0;                   // 0 = hardware concurrency
+    size_t local_table_bytes = 256 * 1024;    // per-thread table, sized to stay in L2
+    size_t radix_bits = 0;                    // 0 = derived from num_threads
+};
+
+// Parallel hash aggregation in two phases:
+//  1. Each thread pre-aggregates a slice of the input into a small
+//     open-addressing table. When the table fills up, its groups are
+//     scattered into radix partitions (by the high hash bits) and the table
+//     is cleared, so the working set stays cache resident.
+//  2. Each partition is merged by one thread into a table sized to the
+//     partition, with no sharing between threads.
+// Groups are identified by a representative input row, so keys are never
+// copied. Output columns follow AggregatePlan::outputs; row order is
+// unspecified. SUM over INTEGER throws std::runtime_error on overflow.
+class HashAggregator {
+public:
+    explicit HashAggregator(const AggregatePlan& plan, AggregateOptions options = {});
+
+    TableData execute(const TableData& input) const;
+
+private:
+    const AggregatePlan& plan;
+    AggregateOptions options;
+};
+
+#endif
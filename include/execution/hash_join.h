@@ -0,0 +1,86 @@
+#ifndef HASH_JOIN_H
+#define HASH_JOIN_H
+
+#include "execution/bloom_filter.h"
+#include "storage/column_data.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+struct JoinOptions {
+    size_t num_threads = 0;        // 0 = hardware concurrency
+    size_t radix_bits = 0;         // 0 = derived from the build size
+    size_t batch_size = 1024;      // matches per emitted batch
+    bool use_bloom_filter = true;
+};
+
+// Matching (build row, probe row) pairs, in parallel arrays.
+struct JoinBatch {
+    std::vector<size_t> build_rows;
+    std::vector<size_t> probe_rows;
+
+    size_t size() const { return build_rows.size(); }
+};
+
+// Parallel radix-partitioned hash join on one equality key.
+//
+// build(): threads hash slices of the build keys and scatter (hash, row)
+// pairs into 2^radix_bits partitions while filling a Bloom filter; then each
+// partition gets its own linear-probing table, built by one thread. Radix
+// bits are chosen so a partition's table fits in L2.
+//
+// filterProbeRows(): the Bloom filter pushed down into the probe-side scan.
+// Threads scan slices of the probe keys and keep only the rows that may have
+// a partner, so rows that miss never reach the join.
+//
+// probe(): threads look up slices of the selected probe rows in the
+// partition tables. Matches are handed to the consumer in batches, from the
+// worker threads, so the consumer must be thread-safe.
+class HashJoin {
+public:
+    explicit HashJoin(JoinOptions options = {});
+
+    void build(const ColumnData& build_keys);
+    // Probes every row, after filterProbeRows() when the Bloom filter is on.
+    void probe(const ColumnData& probe_keys,
+               const std::function<void(const JoinBatch&)>& consumer) const;
+    // Probes only `rows` (ascending probe row ids).
+    void probe(const ColumnData& probe_keys, const std::vector<size_t>& rows,
+               const std::function<void(const JoinBatch&)>& consumer) const;
+
+    // Probe rows whose key passes the Bloom filter, in ascending order; every
+    // row if there is no filter.
+    std::vector<size_t> filterProbeRows(const ColumnData& probe_keys) const;
+
+    // Filter over the build keys, for use by other probe-side operators.
+    const BloomFilter* bloomFilter() const;
+    size_t partitionCount() const;
+    // Probe rows rejected by the last filterProbeRows().
+    uint64_t filteredProbeRows() const;
+
+private:
+    // 8-byte slots: a 32-bit hash tag and a 32-bit build row id.
+    struct Entry {
+        uint32_t tag;
+        uint32_t row;
+    };
+    struct PartitionTable {
+        std::vector<Entry> slots;
+        size_t mask = 0;
+    };
+
+    JoinOptions options;
+    const ColumnData* build_column;
+    size_t radix_bits;
+    std::vector<PartitionTable> partitions;
+    std::unique_ptr<BloomFilter> bloom;
+    mutable std::atomic<uint64_t> filtered_rows;
+
+    size_t partitionOf(uint64_t hash) const;
+    void checkProbeKeys(const ColumnData& probe_keys) const;
+};
+
+#endif
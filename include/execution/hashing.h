@@ -0,0 +1,79 @@
+#ifndef HASHING_H
+#define HASHING_H
+
+#include "storage/column_data.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+// Finalizer from MurmurHash3; spreads entropy into the high bits used for
+// radix partitioning.
+inline uint64_t mixHash(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+inline uint64_t combineHashes(uint64_t seed, uint64_t h) {
+    return mixHash(seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+inline uint64_t hashValue(const ColumnData& column, size_t row) {
+    switch (column.kind()) {
+        case StorageKind::INTEGER:
+            return mixHash(static_cast<uint64_t>(column.integerAt(row)));
+        case StorageKind::FLOAT: {
+            double value = column.floatAt(row);
+            if (value == 0.0) value = 0.0;  // -0.0 and 0.0 compare equal
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return mixHash(bits);
+        }
+        case StorageKind::STRING:
+            return mixHash(std::hash<std::string_view>{}(column.stringAt(row)));
+    }
+    return 0;
+}
+
+inline bool valuesEqual(const ColumnData& a, size_t row_a, const ColumnData& b, size_t row_b) {
+    switch (a.kind()) {
+        case StorageKind::INTEGER: return a.integerAt(row_a) == b.integerAt(row_b);
+        case StorageKind::FLOAT: return a.floatAt(row_a) == b.floatAt(row_b);
+        case StorageKind::STRING: return a.stringAt(row_a) == b.stringAt(row_b);
+    }
+    return false;
+}
+
+inline uint64_t hashRow(const TableData& table, const std::vector<size_t>& key_columns, size_t row) {
+    uint64_t h = 0x2545f4914f6cdd1dULL;
+    for (size_t col : key_columns) {
+        h = combineHashes(h, hashValue(table.columns[col], row));
+    }
+    return h;
+}
+
+inline bool rowsEqual(const TableData& table, const std::vector<size_t>& key_columns,
+                      size_t row_a, size_t row_b) {
+    for (size_t col : key_columns) {
+        if (!valuesEqual(table.columns[col], row_a, table.columns[col], row_b)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline size_t nextPowerOfTwo(size_t n) {
+    size_t power = 1;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 0 means one thread per hardware thread.
+inline size_t resolveThreadCount(size_t requested) {
+    if (requested != 0) {
+        return requested;
+    }
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+// Runs fn(thread_index) on `num_threads` threads and waits for all of them.
+// The first exception thrown by any thread is rethrown to the caller.
+template <typename Fn>
+void runParallel(size_t num_threads, Fn&& fn) {
+    if (num_threads <= 1) {
+        fn(size_t{0});
+        return;
+    }
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            try {
+                fn(t);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Bounds of the t-th of n nearly equal slices of [0, total).
+inline size_t sliceBegin(size_t total, size_t n, size_t t) {
+    return total / n * t + std::min(t, total % n);
+}
+
+#endif
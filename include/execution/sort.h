@@ -0,0 +1,55 @@
+#ifndef SORT_H
+#define SORT_H
+
+#include "binder/binder.h"
+#include "storage/column_data.h"
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct SortOptions {
+    size_t num_threads = 0;                          // 0 = hardware concurrency
+    size_t memory_budget_bytes = 256 * 1024 * 1024;  // for in-memory sort runs
+    std::string temp_directory;                      // empty = system temp dir
+    size_t top_k_threshold = 10000;                  // largest LIMIT using a heap
+    size_t max_merge_fan_in = 64;                    // runs merged at once (>= 2)
+};
+
+// ORDER BY / LIMIT on normalized keys: every row's sort key is encoded into
+// a byte string whose memcmp order is the requested order (with the row id
+// appended, which makes the sort stable).
+//
+// With a LIMIT up to top_k_threshold, each thread keeps a bounded max-heap of
+// its best `limit` keys and the heaps are combined at the end.
+//
+// Otherwise each thread sorts its slice in runs of at most its share of the
+// memory budget; when a run fills up it is spilled to a temp file. The
+// in-memory and spilled runs are combined with a k-way loser-tree merge that
+// stops after `limit` rows. No merge reads more than max_merge_fan_in runs:
+// spilled runs are merged into larger ones in earlier passes, both while
+// they are generated and before the final merge, which bounds the number of
+// open files.
+class Sorter {
+public:
+    explicit Sorter(const SortPlan& plan, SortOptions options = {});
+
+    // Input row ids in sorted order, truncated to the LIMIT.
+    std::vector<size_t> sortedRows(const TableData& input) const;
+    // Sorted rows projected to SortPlan::outputs, truncated to the LIMIT.
+    TableData execute(const TableData& input) const;
+
+    // Sorted runs spilled during run generation by the last sortedRows()
+    // call; runs written by intermediate merges are not counted.
+    size_t spilledRunCount() const;
+
+private:
+    const SortPlan& plan;
+    SortOptions options;
+    mutable std::atomic<size_t> spilled_runs;
+
+    std::vector<size_t> topK(const TableData& input, size_t k, size_t num_threads) const;
+    std::vector<size_t> externalSort(const TableData& input, size_t limit, size_t num_threads) const;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
 
 class AST_NODE{
   public:
@@ -15,8 +16,10 @@ class Expression: public AST_NODE {};
 
 class ColumnExpression : public Expression{
   public:
+    std::string table_name;   // empty unless written as table.column
     std::string column_name;
     explicit ColumnExpression(std::string name);
+    ColumnExpression(std::string table, std::string name);
     std::string toString() const override;
 };
 
@@ -51,13 +54,43 @@ private:
     std::string operatorToString(Operator op) const;
 };
 
+// COUNT/SUM/MIN/MAX/AVG. A null argument means COUNT(*).
+class AggregateExpression : public Expression {
+public:
+    enum class Function { COUNT, SUM, MIN, MAX, AVG };
+    
+    Function function;
+    std::unique_ptr<Expression> argument;
+    
+    AggregateExpression(Function f, std::unique_ptr<Expression> arg);
+    std::string toString() const override;
+    
+    static std::string functionToString(Function f);
+};
+
 class Statement : public AST_NODE {};
 
+// `JOIN table_name ON condition`
+struct JoinClause {
+    std::string table_name;
+    std::unique_ptr<Expression> condition;
+};
+
+// `ORDER BY expression [ASC|DESC]`
+struct OrderByItem {
+    std::unique_ptr<Expression> expression;
+    bool descending = false;
+};
+
 class SelectStatement : public Statement {
 public:
     std::vector<std::unique_ptr<Expression>> columns;
     std::string table_name;
+    std::vector<JoinClause> joins;
     std::unique_ptr<Expression> where_clause;
+    std::vector<std::unique_ptr<Expression>> group_by;
+    std::vector<OrderByItem> order_by;
+    std::optional<size_t> limit;
     
     std::string toString() const override;
 };
@@ -71,4 +104,13 @@ public:
     std::string toString() const override;
 };
 
+// COPY table FROM 'file.csv'
+class CopyStatement : public Statement {
+public:
+    std::string table_name;
+    std::string file_path;
+    
+    std::string toString() const override;
+};
+
 #endif
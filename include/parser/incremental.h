@@ -0,0 +1,84 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "ast.h"
+#include "token.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Replace `removed_length` bytes at `offset` with `inserted_text`.
+struct TextEdit {
+    size_t offset;
+    size_t removed_length;
+    std::string inserted_text;
+};
+
+// One non-empty ';'-separated statement of a script. Token indices are into
+// tokens() and exclude the terminating semicolon. `ast` is null when the
+// statement failed to parse; it stays valid until an edit touches the
+// statement.
+struct ScriptStatement {
+    size_t first_token;
+    size_t end_token;
+    const Statement* ast;
+    std::string error;
+};
+
+// Keeps the tokens and per-statement ASTs of a SQL buffer up to date across
+// edits. The buffer is stored in chunks, one per statement: a chunk holds
+// the text from the end of the previous ';' through its own ';', its tokens
+// with positions relative to the chunk, and its AST.
+//
+// An edit relexes only tokens touching it; lexing stops as soon as a new
+// token starts where a (shifted) old token started, since the lexer carries
+// no state between tokens, and pulls in following chunks only while it runs
+// past the end of the edited ones. Only the edited chunks are reparsed.
+//
+// Chunks before the most recent edit store their absolute offset, chunks
+// after it their distance from the end of the buffer, so an edit does not
+// touch the chunks around it; the next edit only converts the chunks between
+// the two edit points. Edit cost is therefore proportional to the edited
+// statements plus the distance moved since the last edit, not to the length
+// of the script.
+class IncrementalParser {
+private:
+    struct Chunk {
+        size_t position;            // see above
+        std::string text;
+        std::vector<Token> tokens;  // ends with ';' or, in the last chunk, END_OF_FILE
+        std::unique_ptr<Statement> ast;
+        std::string error;
+    };
+
+    std::vector<Chunk> before;      // chunks before the edit point, in order
+    std::vector<Chunk> after;       // chunks from the edit point on, last chunk first
+    size_t total_size;
+    size_t relexed_tokens;
+    size_t reparsed_statements;
+
+    size_t chunkIndexAt(size_t offset) const;
+    void moveSplit(size_t index);
+    void appendChunks(const std::string& text, std::vector<Token> tokens, size_t base);
+    void parseChunk(Chunk& chunk);
+
+    template <typename Visit>
+    void forEachChunk(Visit&& visit) const;
+
+public:
+    explicit IncrementalParser(std::string sql);
+
+    void applyEdit(const TextEdit& edit);
+
+    // Views of the whole script, built on demand in time linear in its size.
+    std::string text() const;
+    std::vector<Token> tokens() const;
+    std::vector<ScriptStatement> statements() const;
+
+    // Work done by the most recent applyEdit (or the initial parse).
+    size_t lastRelexedTokenCount() const;
+    size_t lastReparsedStatementCount() const;
+};
+
+#endif
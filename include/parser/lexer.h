@@ -4,10 +4,12 @@
 #include "token.h"
 #include <vector>
 #include <string>
+#include <string_view>
 
 class Lexer {
 private:
-    std::string input;
+    std::string owned_input;
+    std::string_view input;
     size_t position;
     
     Token readNumber();
@@ -18,7 +20,16 @@ private:
     
 public:
     explicit Lexer(const std::string& sql);
+    // Lexes a caller-owned buffer starting at byte offset `start`. The buffer
+    // must outlive the lexer; token positions are offsets into `sql`.
+    Lexer(std::string_view sql, size_t start);
+
+    Lexer(const Lexer&) = delete;
+    Lexer& operator=(const Lexer&) = delete;
+
     std::vector<Token> tokenize();
+    // Returns the next token, or END_OF_FILE once the input is exhausted.
+    Token nextToken();
 };
 
 #endif 
\ No newline at end of file
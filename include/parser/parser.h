@@ -3,16 +3,21 @@
 
 #include "token.h"
 #include "ast.h"
+#include <cstddef>
 #include <vector>
 #include <memory>
+#include <utility>
 
 class Parser {
 private:
     std::vector<Token> tokens;
     size_t current;
+    size_t nodes_created;
+    size_t depth;  // parsePrimary calls currently on the stack
 
     std::unique_ptr<SelectStatement> parseSelect();
     std::unique_ptr<InsertStatement> parseInsert();
+    std::unique_ptr<CopyStatement> parseCopy();
 
     std::vector<std::unique_ptr<Expression>> parseColumnList();
     std::unique_ptr<Expression> parseExpression();
@@ -20,15 +25,33 @@ private:
     std::unique_ptr<Expression> parseAnd();
     std::unique_ptr<Expression> parseComparison();
     std::unique_ptr<Expression> parsePrimary();
+    std::unique_ptr<Expression> parseAggregate();
+    std::unique_ptr<ColumnExpression> parseColumnReference();
     
     Token peek() const;
+    Token peekNext() const;
     Token advance();
     bool match(TokenType type);
     bool check(TokenType type) const;
+
+    template <typename Node, typename... Args>
+    std::unique_ptr<Node> makeNode(Args&&... args) {
+#ifdef DB_ENABLE_STATS
+        nodes_created++;
+#endif
+        return std::make_unique<Node>(std::forward<Args>(args)...);
+    }
     
 public:
+    // Deepest nesting of parentheses and aggregate calls accepted; deeper
+    // input is rejected before it can exhaust the stack.
+    static constexpr size_t MAX_NESTING_DEPTH = 256;
+
     explicit Parser(std::vector<Token> toks);
     std::unique_ptr<Statement> parse();
+    // Number of AST nodes built by this parser so far; always 0 without
+    // DB_ENABLE_STATS.
+    size_t nodeCount() const;
 };
 
 #endif // PARSER_H
\ No newline at end of file
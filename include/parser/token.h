@@ -2,12 +2,17 @@
 #define TOKEN_H
 #include <string>
 #include <cstddef>
+#include <utility>
 
 enum class TokenType {
     // Keywords
     SELECT, FROM, WHERE, INSERT, INTO, VALUES,
     CREATE, TABLE, DELETE, UPDATE, SET,
     AND, OR, NOT,
+    GROUP, BY,
+    JOIN, INNER, ON,
+    ORDER, ASC, DESC, LIMIT,
+    COPY,
     
     // Literals
     NUMBER,        // 123, 45.67
@@ -31,6 +36,7 @@ enum class TokenType {
     SEMICOLON,     // ;
     LEFT_PAREN,    // (
     RIGHT_PAREN,   // )
+    DOT,           // .
     
     // Special
     END_OF_FILE,
@@ -41,9 +47,14 @@ struct Token {
     TokenType type;
     std::string value;
     size_t position;
+    size_t length;  // bytes of source text covered, including quotes
 
     Token(TokenType t, std::string v, size_t pos)
-        : type(t), value(std::move(v)), position(pos) {}
+        : type(t), value(std::move(v)), position(pos), length(value.size()) {}
+    Token(TokenType t, std::string v, size_t pos, size_t len)
+        : type(t), value(std::move(v)), position(pos), length(len) {}
+
+    size_t end() const { return position + length; }
 };
 
 #endif  
\ No newline at end of file
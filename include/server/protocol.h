@@ -0,0 +1,29 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Wire format: every message is a 4-byte big-endian payload length followed
+// by the payload. A request payload is one SQL statement. A response payload
+// is a status byte followed by the result text (the AST) or an error message.
+// Clients may pipeline any number of requests; responses come back in order.
+
+constexpr size_t FRAME_HEADER_SIZE = 4;
+constexpr size_t MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+enum class ResponseStatus : char {
+    OK = 'K',
+    ERROR = 'E'
+};
+
+void appendFrame(std::string& out, const std::string& payload);
+void appendResponseFrame(std::string& out, ResponseStatus status, const std::string& body);
+
+// Reads the frame starting at `offset`, advancing it past the frame. Returns
+// false if the buffer does not yet hold a complete frame. Throws
+// std::runtime_error if the declared length exceeds MAX_FRAME_SIZE.
+bool readFrame(const std::string& buffer, size_t& offset, std::string& payload);
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "server/worker_pool.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ServerConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = 5433;              // 0 picks a free port, see Server::port()
+    std::string unix_socket_path;      // also listen on this path when set
+    size_t worker_threads = 0;         // 0 = one per hardware thread
+    // Backpressure: a connection is not read from while it has this many
+    // requests without a sent response, or this many unsent response bytes.
+    size_t max_inflight_requests = 1024;
+    size_t max_write_buffer_bytes = 4 * 1024 * 1024;
+};
+
+// Single-threaded epoll event loop speaking the framed protocol in
+// server/protocol.h. Lexing and parsing run on a worker pool; completed
+// responses are handed back to the loop through an eventfd and written to
+// each connection in request order.
+class Server {
+public:
+    explicit Server(ServerConfig cfg);
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Binds and listens; throws std::runtime_error on failure.
+    void start();
+    // Runs the event loop until stop() is called.
+    void run();
+    // Safe to call from any thread or from a signal handler.
+    void stop();
+
+    uint16_t port() const;
+
+private:
+    struct Connection;
+    struct Completion {
+        uint64_t connection_id;
+        uint64_t sequence;
+        std::string frame;
+    };
+
+    ServerConfig config;
+    int epoll_fd;
+    int tcp_listen_fd;
+    int unix_listen_fd;
+    int wakeup_fd;
+    uint16_t bound_port;
+    std::atomic<bool> stopping;
+    uint64_t next_connection_id;
+    std::unordered_map<uint64_t, std::unique_ptr<Connection>> connections;
+    std::unique_ptr<WorkerPool> workers;
+
+    std::mutex completion_mutex;
+    std::vector<Completion> completions;
+
+    void listenTcp();
+    void listenUnix();
+    void acceptConnections(int listen_fd);
+    void readFromConnection(Connection& conn);
+    // Dispatches buffered frames up to the in-flight limit; returns false if
+    // the connection was closed for sending a malformed frame.
+    bool processFrames(Connection& conn);
+    bool overloaded(const Connection& conn) const;
+    void dispatch(Connection& conn, std::vector<std::string> queries);
+    void drainCompletions();
+    void flush(Connection& conn);
+    void updateInterest(Connection& conn);
+    void closeConnection(uint64_t id);
+};
+
+// Lexes and parses one statement, returning an encoded response frame.
+std::string executeRequest(const std::string& sql);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef COLUMN_DATA_H
+#define COLUMN_DATA_H
+
+#include "binder/catalog.h"
+#include "binder/types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Physical representation of a DataType inside a ColumnData.
+enum class StorageKind {
+    INTEGER,   // INTEGER, BOOLEAN (0/1), DATE (days since epoch)
+    FLOAT,
+    STRING
+};
+
+StorageKind storageKindFor(DataType type);
+
+// In-memory column of a single type. Only the vector matching the column's
+// StorageKind is populated.
+class ColumnData {
+public:
+    explicit ColumnData(DataType type);
+
+    DataType type() const;
+    StorageKind kind() const;
+    size_t size() const;
+    void reserve(size_t rows);
+
+    void appendInteger(int64_t value);
+    void appendFloat(double value);
+    void appendString(std::string value);
+    // Parses `text` as a value of the column's type and appends it; returns
+    // false if it is not one. INTEGER/FLOAT use std::from_chars, BOOLEAN
+    // accepts true/false/t/f/1/0 and DATE accepts YYYY-MM-DD.
+    bool appendParsed(std::string_view text);
+    // Appends every row of `other`, which must have the same type.
+    void append(const ColumnData& other);
+    // Same, but moves strings out of `other`.
+    void append(ColumnData&& other);
+    // Appends row `row` of `other`, which must have the same type.
+    void appendFrom(const ColumnData& other, size_t row);
+
+    int64_t integerAt(size_t row) const { return integer_values[row]; }
+    double floatAt(size_t row) const { return float_values[row]; }
+    const std::string& stringAt(size_t row) const { return string_values[row]; }
+    // Value of a numeric column widened to double.
+    double numericAt(size_t row) const {
+        return storage_kind == StorageKind::FLOAT ? float_values[row]
+                                                  : static_cast<double>(integer_values[row]);
+    }
+
+    const std::vector<int64_t>& integers() const { return integer_values; }
+    const std::vector<double>& floats() const { return float_values; }
+    const std::vector<std::string>& strings() const { return string_values; }
+
+private:
+    DataType data_type;
+    StorageKind storage_kind;
+    std::vector<int64_t> integer_values;
+    std::vector<double> float_values;
+    std::vector<std::string> string_values;
+};
+
+// Column-major rows of a table; columns are in TableInfo column order.
+class TableData {
+public:
+    std::vector<ColumnData> columns;
+
+    TableData() = default;
+    explicit TableData(const TableInfo& info);
+    explicit TableData(const std::vector<DataType>& types);
+
+    size_t rowCount() const;
+    // Appends all rows of `other`, which must have the same column types.
+    void append(const TableData& other);
+};
+
+#endif
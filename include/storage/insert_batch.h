@@ -0,0 +1,17 @@
+#ifndef INSERT_BATCH_H
+#define INSERT_BATCH_H
+
+#include "binder/catalog.h"
+#include "parser/ast.h"
+#include "storage/column_data.h"
+#include <vector>
+
+// Converts the VALUES of INSERT statements into typed rows of `table`, one
+// row per statement. Every statement must target `table` and supply a value
+// for every column (there are no NULLs); an explicit column list may give
+// them in any order. INTEGER and FLOAT need number literals, VARCHAR and
+// DATE need string literals and BOOLEAN takes either. Throws
+// std::runtime_error on the first mismatch.
+TableData buildInsertBatch(const TableInfo& table, const std::vector<const InsertStatement*>& statements);
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef WAL_H
+#define WAL_H
+
+#include "storage/column_data.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct WalOptions {
+    size_t max_batch_records = 1024;                // commit early once this many are pending
+    std::chrono::microseconds max_commit_delay{0};  // how long a group may wait to fill up
+    bool sync = true;                               // fdatasync every group commit
+};
+
+// Write-ahead log of INSERT batches. Each record holds the rows of one batch
+// (see buildInsertBatch) for one table_id:
+//
+//   [u32 payload bytes][u32 CRC-32 of payload]
+//   payload: [u64 table_id][u32 rows][u32 columns]
+//            per column: [u8 DataType] then rows x (i64 | f64 | u32 length + bytes)
+//
+// in host byte order. Appenders encode their record in parallel and hand it
+// to a single log-writer thread, which writes everything pending with one
+// write() and one fdatasync() (group commit) and then wakes the appenders.
+// With max_commit_delay > 0 the writer waits up to that long for
+// max_batch_records records before committing; with 0 it commits whatever
+// arrived while the previous fdatasync was running.
+class WriteAheadLog {
+public:
+    // Opens or creates the log, cuts off a torn or corrupt tail left by a
+    // crash and starts the writer thread.
+    explicit WriteAheadLog(const std::string& path, WalOptions options = {});
+    // Commits what is pending and stops the writer.
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Logs `rows` and blocks until they are durable. Returns the record's
+    // sequence number (its 1-based position in the log). Thread safe; throws
+    // std::runtime_error if the log can no longer be written.
+    uint64_t append(size_t table_id, const TableData& rows);
+
+    // Sequence number of the last durable record.
+    uint64_t durableLsn() const;
+    // Group commits performed by this instance.
+    uint64_t commitCount() const;
+
+    // Calls apply(table_id, rows) for every intact record in log order and
+    // returns how many there were. Stops at the first torn or corrupt record.
+    static size_t replay(const std::string& path,
+                         const std::function<void(size_t, TableData&&)>& apply);
+
+private:
+    int fd;
+    WalOptions options;
+    std::string pending;           // encoded records not yet handed to the writer
+    size_t pending_records;
+    uint64_t next_lsn;
+    uint64_t durable_lsn;
+    uint64_t commits;
+    bool stopping;
+    std::string error;             // set once a write or sync failed
+    mutable std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable committed;
+    std::thread writer;
+
+    void writerLoop();
+};
+
+#endif
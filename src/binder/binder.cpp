@@ -0,0 +1,263 @@
+#include "binder/binder.h"
+#include "common/stats.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+DataType aggregateResultType(AggregateExpression::Function function, DataType input) {
+    const std::string name = AggregateExpression::functionToString(function);
+    switch (function) {
+        case AggregateExpression::Function::COUNT:
+            return DataType::INTEGER;
+        case AggregateExpression::Function::SUM:
+            if (!isNumericType(input)) {
+                throw std::runtime_error(name + " requires a numeric argument, got " +
+                                         dataTypeToString(input));
+            }
+            return promoteNumericTypes(input, input);
+        case AggregateExpression::Function::AVG:
+            if (!isNumericType(input)) {
+                throw std::runtime_error(name + " requires a numeric argument, got " +
+                                         dataTypeToString(input));
+            }
+            return promoteNumericTypes(input, DataType::FLOAT);
+        case AggregateExpression::Function::MIN:
+        case AggregateExpression::Function::MAX:
+            if (input == DataType::UNKNOWN) {
+                throw std::runtime_error(name + " cannot be applied to UNKNOWN");
+            }
+            return input;
+    }
+    return DataType::UNKNOWN;
+}
+
+Binder::Binder(const Catalog& catalog) : catalog(catalog) {}
+
+bool Binder::hasAggregates(const SelectStatement& stmt) {
+    if (!stmt.group_by.empty()) {
+        return true;
+    }
+    for (const auto& col : stmt.columns) {
+        if (dynamic_cast<const AggregateExpression*>(col.get()) != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const TableInfo& Binder::resolveTable(const std::string& name) const {
+    const TableInfo* table = catalog.getTable(name);
+    if (table == nullptr) {
+        throw std::runtime_error("Table '" + name + "' does not exist");
+    }
+    return *table;
+}
+
+const ColumnInfo& Binder::resolveColumn(const TableInfo& table, const Expression& expr) const {
+    const ColumnInfo* info = nullptr;
+    resolveColumn({&table}, expr, info);
+    return *info;
+}
+
+size_t Binder::resolveColumn(const std::vector<const TableInfo*>& tables, const Expression& expr,
+                             const ColumnInfo*& column) const {
+    const auto* ref = dynamic_cast<const ColumnExpression*>(&expr);
+    if (ref == nullptr) {
+        throw std::runtime_error("Expected a column reference, got " + expr.toString());
+    }
+    
+    size_t owner = tables.size();
+    column = nullptr;
+    for (size_t i = 0; i < tables.size(); ++i) {
+        if (!ref->table_name.empty() &&
+            catalog.getTable(ref->table_name) != tables[i]) {
+            continue;
+        }
+        const ColumnInfo* info = tables[i]->getColumn(ref->column_name);
+        if (info == nullptr) {
+            continue;
+        }
+        if (column != nullptr) {
+            throw std::runtime_error("Column reference '" + ref->column_name + "' is ambiguous");
+        }
+        column = info;
+        owner = i;
+    }
+    
+    if (column == nullptr) {
+        if (!ref->table_name.empty() && catalog.getTable(ref->table_name) == nullptr) {
+            throw std::runtime_error("Table '" + ref->table_name + "' does not exist");
+        }
+        std::string where = ref->table_name.empty() ? tables.front()->name : ref->table_name;
+        throw std::runtime_error("Column '" + ref->column_name +
+                                 "' does not exist in table '" + where + "'");
+    }
+    return owner;
+}
+
+AggregatePlan Binder::bindAggregate(const SelectStatement& stmt) const {
+    DB_STATS_PHASE(Phase::BIND);
+    AggregatePlan plan;
+    plan.table = &resolveTable(stmt.table_name);
+    const TableInfo& table = *plan.table;
+    
+    if (stmt.where_clause) {
+        throw std::runtime_error("WHERE is not supported together with aggregation yet");
+    }
+    if (!stmt.joins.empty()) {
+        throw std::runtime_error("Aggregation over joins is not supported yet");
+    }
+    if (!stmt.order_by.empty() || stmt.limit) {
+        throw std::runtime_error("ORDER BY and LIMIT over aggregates are not supported yet");
+    }
+    
+    for (const auto& key : stmt.group_by) {
+        plan.group_columns.push_back(resolveColumn(table, *key).column_id);
+    }
+    
+    for (const auto& item : stmt.columns) {
+        const auto* aggregate = dynamic_cast<const AggregateExpression*>(item.get());
+        if (aggregate == nullptr) {
+            const auto* column = dynamic_cast<const ColumnExpression*>(item.get());
+            if (column != nullptr && column->column_name == "*") {
+                throw std::runtime_error("SELECT * cannot be used with GROUP BY or aggregates");
+            }
+            const ColumnInfo& info = resolveColumn(table, *item);
+            size_t key_index = 0;
+            while (key_index < plan.group_columns.size() &&
+                   plan.group_columns[key_index] != info.column_id) {
+                key_index++;
+            }
+            if (key_index == plan.group_columns.size()) {
+                throw std::runtime_error("Column '" + info.name +
+                                         "' must appear in GROUP BY or be aggregated");
+            }
+            plan.outputs.push_back({false, key_index, info.name, info.type});
+            continue;
+        }
+        
+        AggregateSpec spec{aggregate->function, false, 0, DataType::UNKNOWN, DataType::INTEGER};
+        if (aggregate->argument) {
+            if (dynamic_cast<const AggregateExpression*>(aggregate->argument.get()) != nullptr) {
+                throw std::runtime_error("Aggregate calls cannot be nested");
+            }
+            const ColumnInfo& info = resolveColumn(table, *aggregate->argument);
+            spec.has_argument = true;
+            spec.column_id = info.column_id;
+            spec.input_type = info.type;
+        } else if (aggregate->function != AggregateExpression::Function::COUNT) {
+            throw std::runtime_error(AggregateExpression::functionToString(aggregate->function) +
+                                     " requires an argument");
+        }
+        spec.result_type = aggregateResultType(spec.function, spec.input_type);
+        
+        plan.outputs.push_back({true, plan.aggregates.size(), aggregate->toString(), spec.result_type});
+        plan.aggregates.push_back(spec);
+    }
+    return plan;
+}
+
+JoinPlan Binder::bindJoin(const SelectStatement& stmt) const {
+    DB_STATS_PHASE(Phase::BIND);
+    if (stmt.joins.size() != 1) {
+        throw std::runtime_error("Expected exactly one JOIN clause");
+    }
+    const JoinClause& join = stmt.joins.front();
+    if (stmt.where_clause) {
+        throw std::runtime_error("WHERE is not supported together with JOIN yet");
+    }
+    if (hasAggregates(stmt)) {
+        throw std::runtime_error("Aggregation over joins is not supported yet");
+    }
+    if (!stmt.order_by.empty() || stmt.limit) {
+        throw std::runtime_error("ORDER BY and LIMIT over joins are not supported yet");
+    }
+    
+    JoinPlan plan{};
+    plan.left_table = &resolveTable(stmt.table_name);
+    plan.right_table = &resolveTable(join.table_name);
+    if (plan.left_table == plan.right_table) {
+        throw std::runtime_error("Self-joins are not supported");
+    }
+    
+    const auto* condition = dynamic_cast<const BinaryExpression*>(join.condition.get());
+    if (condition == nullptr || condition->op != BinaryExpression::Operator::EQUALS) {
+        throw std::runtime_error("JOIN condition must be an equality between two columns");
+    }
+    
+    std::vector<const TableInfo*> tables = {plan.left_table, plan.right_table};
+    const ColumnInfo* first = nullptr;
+    const ColumnInfo* second = nullptr;
+    size_t first_owner = resolveColumn(tables, *condition->left, first);
+    size_t second_owner = resolveColumn(tables, *condition->right, second);
+    if (first_owner == second_owner) {
+        throw std::runtime_error("JOIN condition must compare columns of both tables");
+    }
+    if (first->type != second->type) {
+        throw std::runtime_error("Type mismatch: cannot join " + dataTypeToString(first->type) +
+                                 " with " + dataTypeToString(second->type));
+    }
+    
+    plan.left_key = first_owner == 0 ? first->column_id : second->column_id;
+    plan.right_key = first_owner == 0 ? second->column_id : first->column_id;
+    plan.key_type = first->type;
+    
+    for (const auto& item : stmt.columns) {
+        const auto* column = dynamic_cast<const ColumnExpression*>(item.get());
+        if (column != nullptr && column->column_name == "*") {
+            for (size_t side = 0; side < tables.size(); ++side) {
+                for (const ColumnInfo& info : tables[side]->columns) {
+                    plan.outputs.push_back({side == 1, info.column_id, info.name, info.type});
+                }
+            }
+            continue;
+        }
+        const ColumnInfo* info = nullptr;
+        size_t owner = resolveColumn(tables, *item, info);
+        plan.outputs.push_back({owner == 1, info->column_id, info->name, info->type});
+    }
+    return plan;
+}
+
+SortPlan Binder::bindSort(const SelectStatement& stmt) const {
+    DB_STATS_PHASE(Phase::BIND);
+    if (!stmt.joins.empty() || hasAggregates(stmt)) {
+        throw std::runtime_error("ORDER BY over joins or aggregates is not supported yet");
+    }
+    if (stmt.where_clause) {
+        throw std::runtime_error("WHERE is not supported together with ORDER BY yet");
+    }
+    
+    SortPlan plan;
+    plan.table = &resolveTable(stmt.table_name);
+    plan.limit = stmt.limit;
+    for (const auto& item : stmt.order_by) {
+        const ColumnInfo& info = resolveColumn(*plan.table, *item.expression);
+        plan.keys.push_back({info.column_id, info.type, item.descending});
+    }
+    for (const auto& item : stmt.columns) {
+        const auto* column = dynamic_cast<const ColumnExpression*>(item.get());
+        if (column != nullptr && column->column_name == "*") {
+            for (const ColumnInfo& info : plan.table->columns) {
+                plan.outputs.push_back({info.column_id, info.name, info.type});
+            }
+            continue;
+        }
+        const ColumnInfo& info = resolveColumn(*plan.table, *item);
+        plan.outputs.push_back({info.column_id, info.name, info.type});
+    }
+    return plan;
+}
+
+CopyPlan Binder::bindCopy(const CopyStatement& stmt) const {
+    DB_STATS_PHASE(Phase::BIND);
+    if (stmt.file_path.empty()) {
+        throw std::runtime_error("COPY requires a file path");
+    }
+    
+    CopyPlan plan;
+    plan.table = &resolveTable(stmt.table_name);
+    plan.file_path = stmt.file_path;
+    return plan;
+}
@@ -0,0 +1,62 @@
+#include "binder/catalog.h"
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+bool equalsIgnoreCase(const std::string& a, const std::string& b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) ==
+                      std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+// ColumnInfo
+ColumnInfo::ColumnInfo(std::string n, DataType t, size_t id, bool nullable, size_t len)
+    : name(std::move(n)), type(t), column_id(id), nullable(nullable), max_length(len) {}
+
+// TableInfo
+TableInfo::TableInfo(std::string n, size_t id) : name(std::move(n)), table_id(id) {}
+
+void TableInfo::addColumn(const ColumnInfo& col) {
+    columns.push_back(col);
+}
+
+const ColumnInfo* TableInfo::getColumn(const std::string& col_name) const {
+    for (const auto& col : columns) {
+        if (equalsIgnoreCase(col.name, col_name)) {
+            return &col;
+        }
+    }
+    return nullptr;
+}
+
+// Catalog
+TableInfo* Catalog::createTable(const std::string& name) {
+    if (getTable(name) != nullptr) {
+        throw std::runtime_error("Table '" + name + "' already exists");
+    }
+    tables.push_back(std::make_unique<TableInfo>(name, tables.size()));
+    return tables.back().get();
+}
+
+TableInfo* Catalog::getTable(const std::string& name) {
+    for (auto& table : tables) {
+        if (equalsIgnoreCase(table->name, name)) {
+            return table.get();
+        }
+    }
+    return nullptr;
+}
+
+const TableInfo* Catalog::getTable(const std::string& name) const {
+    return const_cast<Catalog*>(this)->getTable(name);
+}
+
+const TableInfo* Catalog::getTableById(size_t table_id) const {
+    return table_id < tables.size() ? tables[table_id].get() : nullptr;
+}
@@ -0,0 +1,319 @@
+#include "common/stats.h"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+
+namespace {
+
+thread_local uint64_t thread_allocated_bytes = 0;
+thread_local uint64_t thread_allocation_count = 0;
+
+const double REPORTED_PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+
+int highestBit(uint64_t value) {
+    return 63 - __builtin_clzll(value);
+}
+
+std::string quantileLabel(double p) {
+    std::ostringstream out;
+    out << p / 100.0;
+    return out.str();
+}
+
+std::string percentileKey(double p) {
+    std::ostringstream out;
+    out << "p" << p;
+    std::string key = out.str();
+    for (char& c : key) {
+        if (c == '.') c = '_';
+    }
+    return key;
+}
+
+void updateMin(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value < current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void updateMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+#ifdef DB_ENABLE_STATS
+// Counting replacements for the global allocation functions. Frees are not
+// tracked; the figures are allocation volume, not live heap size.
+void* operator new(std::size_t size) {
+    thread_allocated_bytes += size;
+    thread_allocation_count++;
+    if (size == 0) size = 1;
+    while (true) {
+        if (void* ptr = std::malloc(size)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+#endif
+
+uint64_t threadAllocatedBytes() {
+    return thread_allocated_bytes;
+}
+
+uint64_t threadAllocationCount() {
+    return thread_allocation_count;
+}
+
+std::string phaseToString(Phase phase) {
+    switch (phase) {
+        case Phase::LEX: return "lex";
+        case Phase::PARSE: return "parse";
+        case Phase::BIND: return "bind";
+        case Phase::NUM_PHASES: break;
+    }
+    return "unknown";
+}
+
+std::string counterToString(Counter counter) {
+    switch (counter) {
+        case Counter::TOKENS: return "tokens";
+        case Counter::AST_NODES: return "ast_nodes";
+        case Counter::STATEMENTS: return "statements";
+        case Counter::NUM_COUNTERS: break;
+    }
+    return "unknown";
+}
+
+// LatencyHistogram
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+    size_t shift = static_cast<size_t>(highestBit(value)) - SUB_BUCKET_BITS;
+    size_t sub = static_cast<size_t>(value >> shift) - SUB_BUCKETS;
+    return (shift + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    size_t shift = index / SUB_BUCKETS - 1;
+    uint64_t sub = index % SUB_BUCKETS;
+    uint64_t lower = (SUB_BUCKETS + sub) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    total_count.fetch_add(1, std::memory_order_relaxed);
+    total_sum.fetch_add(value, std::memory_order_relaxed);
+    updateMin(min_value, value);
+    updateMax(max_value, value);
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    total_count.store(0, std::memory_order_relaxed);
+    total_sum.store(0, std::memory_order_relaxed);
+    min_value.store(UINT64_MAX, std::memory_order_relaxed);
+    max_value.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const {
+    return total_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::sum() const {
+    return total_sum.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::min() const {
+    return count() == 0 ? 0 : min_value.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::max() const {
+    return max_value.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    auto target = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total) + 0.5);
+    if (target == 0) target = 1;
+    if (target > total) target = total;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            uint64_t bound = bucketUpperBound(i);
+            return bound < max() ? bound : max();
+        }
+    }
+    return max();
+}
+
+// Stats
+Stats& Stats::instance() {
+    static Stats stats;
+    return stats;
+}
+
+void Stats::recordPhase(Phase p, uint64_t nanos, uint64_t bytes, uint64_t allocs) {
+    PhaseStats& stats = phases[static_cast<size_t>(p)];
+    stats.latency.record(nanos);
+    stats.total_ns.fetch_add(nanos, std::memory_order_relaxed);
+    stats.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+    stats.allocations.fetch_add(allocs, std::memory_order_relaxed);
+}
+
+void Stats::addCounter(Counter c, uint64_t amount) {
+    counters[static_cast<size_t>(c)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+const PhaseStats& Stats::phase(Phase p) const {
+    return phases[static_cast<size_t>(p)];
+}
+
+uint64_t Stats::counter(Counter c) const {
+    return counters[static_cast<size_t>(c)].load(std::memory_order_relaxed);
+}
+
+void Stats::reset() {
+    for (auto& stats : phases) {
+        stats.latency.reset();
+        stats.total_ns.store(0, std::memory_order_relaxed);
+        stats.bytes_allocated.store(0, std::memory_order_relaxed);
+        stats.allocations.store(0, std::memory_order_relaxed);
+    }
+    for (auto& c : counters) {
+        c.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string Stats::toJson() const {
+    std::ostringstream out;
+    out << "{\"phases\":{";
+    for (size_t i = 0; i < phases.size(); ++i) {
+        const PhaseStats& stats = phases[i];
+        if (i > 0) out << ",";
+        out << "\"" << phaseToString(static_cast<Phase>(i)) << "\":{"
+            << "\"calls\":" << stats.latency.count()
+            << ",\"total_ns\":" << stats.total_ns.load(std::memory_order_relaxed)
+            << ",\"bytes_allocated\":" << stats.bytes_allocated.load(std::memory_order_relaxed)
+            << ",\"allocations\":" << stats.allocations.load(std::memory_order_relaxed)
+            << ",\"latency_ns\":{\"min\":" << stats.latency.min();
+        for (double p : REPORTED_PERCENTILES) {
+            out << ",\"" << percentileKey(p) << "\":" << stats.latency.percentile(p);
+        }
+        out << ",\"max\":" << stats.latency.max() << "}}";
+    }
+    out << "},\"counters\":{";
+    for (size_t i = 0; i < counters.size(); ++i) {
+        if (i > 0) out << ",";
+        out << "\"" << counterToString(static_cast<Counter>(i)) << "\":"
+            << counters[i].load(std::memory_order_relaxed);
+    }
+    out << "}}";
+    return out.str();
+}
+
+std::string Stats::toPrometheus() const {
+    std::ostringstream out;
+
+    auto phaseMetric = [&](const std::string& name, const std::string& type,
+                           const std::string& help, auto value) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+        for (size_t i = 0; i < phases.size(); ++i) {
+            out << name << "{phase=\"" << phaseToString(static_cast<Phase>(i)) << "\"} "
+                << value(phases[i]) << "\n";
+        }
+    };
+
+    phaseMetric("db_phase_allocated_bytes_total", "counter",
+                "Bytes allocated while running a front-end phase.",
+                [](const PhaseStats& s) { return s.bytes_allocated.load(std::memory_order_relaxed); });
+    phaseMetric("db_phase_allocations_total", "counter",
+                "Allocation calls made while running a front-end phase.",
+                [](const PhaseStats& s) { return s.allocations.load(std::memory_order_relaxed); });
+
+    out << "# HELP db_phase_latency_nanoseconds Latency of a front-end phase.\n";
+    out << "# TYPE db_phase_latency_nanoseconds summary\n";
+    for (size_t i = 0; i < phases.size(); ++i) {
+        const PhaseStats& stats = phases[i];
+        std::string label = "phase=\"" + phaseToString(static_cast<Phase>(i)) + "\"";
+        for (double p : REPORTED_PERCENTILES) {
+            out << "db_phase_latency_nanoseconds{" << label << ",quantile=\""
+                << quantileLabel(p) << "\"} " << stats.latency.percentile(p) << "\n";
+        }
+        out << "db_phase_latency_nanoseconds_sum{" << label << "} "
+            << stats.total_ns.load(std::memory_order_relaxed) << "\n";
+        out << "db_phase_latency_nanoseconds_count{" << label << "} "
+            << stats.latency.count() << "\n";
+    }
+
+    for (size_t i = 0; i < counters.size(); ++i) {
+        std::string name = "db_" + counterToString(static_cast<Counter>(i)) + "_total";
+        out << "# TYPE " << name << " counter\n";
+        out << name << " " << counters[i].load(std::memory_order_relaxed) << "\n";
+    }
+    return out.str();
+}
+
+// ScopedPhaseTimer
+ScopedPhaseTimer::ScopedPhaseTimer(Phase p)
+    : phase(p),
+      start(std::chrono::steady_clock::now()),
+      start_bytes(thread_allocated_bytes),
+      start_allocs(thread_allocation_count) {}
+
+ScopedPhaseTimer::~ScopedPhaseTimer() {
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    Stats::instance().recordPhase(phase,
+                                  static_cast<uint64_t>(elapsed.count()),
+                                  thread_allocated_bytes - start_bytes,
+                                  thread_allocation_count - start_allocs);
+}
@@ -0,0 +1,40 @@
+#include "execution/bloom_filter.h"
+#include "execution/hashing.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+BloomFilter::BloomFilter(size_t expected_keys, size_t bits_per_key)
+    : num_words(nextPowerOfTwo(std::max<size_t>(1, expected_keys * bits_per_key / 64))),
+      word_mask(num_words - 1) {
+    words = std::make_unique<std::atomic<uint64_t>[]>(num_words);
+    for (size_t i = 0; i < num_words; ++i) {
+        words[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+// Join hashes put their high bits into radix partitioning and their low
+// bits into table slots, so the filter rehashes to stay independent of both.
+uint64_t BloomFilter::wordPattern(uint64_t hash) {
+    uint64_t pattern = 0;
+    for (size_t i = 0; i < PROBES; ++i) {
+        pattern |= uint64_t{1} << ((hash >> (32 + 6 * i)) & 63);
+    }
+    return pattern;
+}
+
+void BloomFilter::insert(uint64_t hash) {
+    uint64_t h = mixHash(hash ^ 0x5bd1e9955bd1e995ULL);
+    words[h & word_mask].fetch_or(wordPattern(h), std::memory_order_relaxed);
+}
+
+bool BloomFilter::mayContain(uint64_t hash) const {
+    uint64_t h = mixHash(hash ^ 0x5bd1e9955bd1e995ULL);
+    uint64_t pattern = wordPattern(h);
+    return (words[h & word_mask].load(std::memory_order_relaxed) & pattern) == pattern;
+}
+
+size_t BloomFilter::sizeInBytes() const {
+    return num_words * sizeof(uint64_t);
+}
@@ -0,0 +1,260 @@
+#include "execution/csv_loader.h"
+#include "execution/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Read-only mapping of a whole file.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) : data(nullptr), size(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open '" + path + "': " + std::strerror(errno));
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error("Cannot stat '" + path + "': " + std::strerror(errno));
+        }
+        size = static_cast<size_t>(st.st_size);
+        if (size > 0) {
+            void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Cannot map '" + path + "': " + std::strerror(errno));
+            }
+            madvise(mapped, size, MADV_WILLNEED);
+            data = static_cast<const char*>(mapped);
+        }
+        close(fd);
+    }
+
+    ~MappedFile() {
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view view() const { return std::string_view(data, size); }
+
+private:
+    const char* data;
+    size_t size;
+};
+
+// Offset just past the first newline at or after `pos` that is not inside a
+// quoted field, or text.size() if there is none.
+size_t nextRecordStart(std::string_view text, size_t pos, bool in_quotes) {
+    for (; pos < text.size(); ++pos) {
+        char c = text[pos];
+        if (c == '"') {
+            in_quotes = !in_quotes;
+        } else if (c == '\n' && !in_quotes) {
+            return pos + 1;
+        }
+    }
+    return text.size();
+}
+
+[[noreturn]] void fail(std::string_view text, size_t pos, const std::string& message) {
+    size_t line = 1 + std::count(text.begin(), text.begin() + std::min(pos, text.size()), '\n');
+    throw std::runtime_error("CSV line " + std::to_string(line) + ": " + message);
+}
+
+} // namespace
+
+CsvLoader::CsvLoader(const TableInfo& table, CsvOptions options)
+    : table(table), options(std::move(options)) {
+    if (table.columns.empty()) {
+        throw std::runtime_error("Table '" + table.name + "' has no columns");
+    }
+    if (this->options.delimiter == '"' || this->options.delimiter == '\n' ||
+        this->options.delimiter == '\r') {
+        throw std::runtime_error("Invalid CSV delimiter");
+    }
+}
+
+size_t CsvLoader::loadFile(const std::string& path, TableData& target) const {
+    MappedFile file(path);
+    return load(file.view(), target);
+}
+
+size_t CsvLoader::load(std::string_view text, TableData& target) const {
+    if (target.columns.size() != table.columns.size()) {
+        throw std::runtime_error("COPY target does not match table '" + table.name + "'");
+    }
+    for (size_t c = 0; c < table.columns.size(); ++c) {
+        if (target.columns[c].type() != table.columns[c].type) {
+            throw std::runtime_error("COPY target does not match table '" + table.name + "'");
+        }
+    }
+
+    const size_t start = options.header ? nextRecordStart(text, 0, false) : 0;
+    const size_t bytes = text.size() - start;
+    if (bytes == 0) {
+        return 0;
+    }
+    const size_t chunk_bytes = std::max<size_t>(1, options.chunk_bytes);
+    const size_t num_chunks = (bytes + chunk_bytes - 1) / chunk_bytes;
+    const size_t num_threads = std::min(resolveThreadCount(options.num_threads), num_chunks);
+    auto rawStart = [&](size_t chunk) { return start + std::min(bytes, chunk * chunk_bytes); };
+
+    // Pass 1: quote parity of every raw chunk; a prefix XOR then tells each
+    // chunk whether it begins inside a quoted field.
+    std::vector<char> odd_quotes(num_chunks);
+    std::atomic<size_t> next_chunk{0};
+    runParallel(num_threads, [&](size_t) {
+        for (size_t i = next_chunk++; i < num_chunks; i = next_chunk++) {
+            odd_quotes[i] = std::count(text.begin() + rawStart(i), text.begin() + rawStart(i + 1), '"') & 1;
+        }
+    });
+    std::vector<char> in_quotes(num_chunks, 0);
+    for (size_t i = 1; i < num_chunks; ++i) {
+        in_quotes[i] = in_quotes[i - 1] ^ odd_quotes[i - 1];
+    }
+
+    // Pass 2: move chunk edges to record boundaries and parse each chunk
+    // into its own batch. Neighbours compute the shared edge identically.
+    std::vector<TableData> batches(num_chunks);
+    next_chunk = 0;
+    runParallel(num_threads, [&](size_t) {
+        for (size_t i = next_chunk++; i < num_chunks; i = next_chunk++) {
+            size_t begin = i == 0 ? start : nextRecordStart(text, rawStart(i), in_quotes[i]);
+            size_t end = i + 1 == num_chunks ? text.size()
+                                             : nextRecordStart(text, rawStart(i + 1), in_quotes[i + 1]);
+            if (begin < end) {
+                batches[i] = parseChunk(text, begin, end);
+            }
+        }
+    });
+
+    size_t rows = 0;
+    for (const TableData& batch : batches) {
+        rows += batch.rowCount();
+    }
+    const size_t num_columns = target.columns.size();
+    const size_t append_threads = std::min(num_threads, num_columns);
+    runParallel(append_threads, [&](size_t t) {
+        for (size_t c = t; c < num_columns; c += append_threads) {
+            ColumnData& column = target.columns[c];
+            column.reserve(column.size() + rows);
+            for (TableData& batch : batches) {
+                if (!batch.columns.empty()) {
+                    column.append(std::move(batch.columns[c]));
+                }
+            }
+        }
+    });
+    return rows;
+}
+
+TableData CsvLoader::parseChunk(std::string_view text, size_t begin, size_t end) const {
+    TableData batch(table);
+    const size_t num_columns = batch.columns.size();
+    const char delimiter = options.delimiter;
+    std::string unescaped;
+    size_t pos = begin;
+
+    while (pos < end) {
+        if (text[pos] == '\n' || (text[pos] == '\r' && pos + 1 < end && text[pos + 1] == '\n')) {
+            pos += text[pos] == '\n' ? 1 : 2;
+            continue;
+        }
+
+        for (size_t c = 0; c < num_columns; ++c) {
+            std::string_view field;
+            const bool quoted = pos < end && text[pos] == '"';
+            if (quoted) {
+                const size_t open = pos++;
+                size_t segment = pos;
+                bool escaped = false;
+                unescaped.clear();
+                while (true) {
+                    const void* found = std::memchr(text.data() + pos, '"', end - pos);
+                    if (found == nullptr) {
+                        fail(text, open, "Unterminated quoted field");
+                    }
+                    size_t quote = static_cast<const char*>(found) - text.data();
+                    if (quote + 1 < end && text[quote + 1] == '"') {
+                        unescaped.append(text.data() + segment, quote + 1 - segment);
+                        escaped = true;
+                        pos = quote + 2;
+                        segment = pos;
+                        continue;
+                    }
+                    if (escaped) {
+                        unescaped.append(text.data() + segment, quote - segment);
+                        field = unescaped;
+                    } else {
+                        field = text.substr(segment, quote - segment);
+                    }
+                    pos = quote + 1;
+                    break;
+                }
+            } else {
+                const size_t field_start = pos;
+                while (pos < end && text[pos] != delimiter && text[pos] != '\n' && text[pos] != '"') {
+                    ++pos;
+                }
+                if (pos < end && text[pos] == '"') {
+                    fail(text, pos, "Unexpected quote in unquoted field");
+                }
+                field = text.substr(field_start, pos - field_start);
+                if (!field.empty() && field.back() == '\r' && (pos == end || text[pos] == '\n')) {
+                    field.remove_suffix(1);
+                }
+                if (field.empty() && table.columns[c].type != DataType::VARCHAR) {
+                    fail(text, field_start, "NULL values are not supported (column " +
+                                            table.columns[c].name + ")");
+                }
+            }
+
+            if (!batch.columns[c].appendParsed(field)) {
+                fail(text, pos, "Invalid " + dataTypeToString(table.columns[c].type) + " value '" +
+                                std::string(field) + "' for column " + table.columns[c].name);
+            }
+
+            if (c + 1 < num_columns) {
+                if (pos < end && text[pos] == delimiter) {
+                    ++pos;
+                } else if (pos >= end || text[pos] == '\n' || text[pos] == '\r') {
+                    fail(text, pos, "Expected " + std::to_string(num_columns) + " fields, got " +
+                                    std::to_string(c + 1));
+                } else {
+                    fail(text, pos, "Unexpected character after quoted field");
+                }
+            }
+        }
+
+        if (pos < end && text[pos] == '\r') {
+            ++pos;
+        }
+        if (pos < end) {
+            if (text[pos] == delimiter) {
+                fail(text, pos, "Expected " + std::to_string(num_columns) + " fields, got more");
+            }
+            if (text[pos] != '\n') {
+                fail(text, pos, "Unexpected character after quoted field");
+            }
+            ++pos;
+        }
+    }
+    return batch;
+}
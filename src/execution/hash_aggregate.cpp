@@ -0,0 +1,356 @@
+#include "execution/hash_aggregate.h"
+#include "execution/hashing.h"
+#include "execution/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct AggregateState {
+    int64_t count = 0;
+    int64_t int_value = 0;
+    double float_value = 0.0;
+    size_t row = 0;           // current MIN/MAX row for string inputs
+    bool has_value = false;
+};
+
+// Groups spilled from thread-local tables into one radix partition.
+struct PartialGroups {
+    std::vector<uint64_t> hashes;
+    std::vector<size_t> rows;
+    std::vector<AggregateState> states;  // num_aggregates per group
+};
+
+// Open-addressing table with linear probing. Slots hold the full hash and a
+// group index; group keys are compared through their representative rows.
+class GroupTable {
+public:
+    std::vector<uint64_t> hashes;
+    std::vector<size_t> rows;
+    std::vector<AggregateState> states;
+
+    // Sized for up to `max_groups` groups at a load factor of at most 1/2.
+    GroupTable(size_t max_groups, size_t num_aggregates)
+        : slots(slotCount(max_groups), Slot{0, EMPTY_SLOT}),
+          mask(slots.size() - 1),
+          num_aggregates(num_aggregates) {}
+
+    static size_t slotCount(size_t max_groups) { return nextPowerOfTwo(2 * max_groups); }
+
+    // Memory of a table holding `max_groups` groups, with the group arrays
+    // reserved up front.
+    static size_t bytesFor(size_t max_groups, size_t num_aggregates) {
+        return slotCount(max_groups) * sizeof(Slot) +
+               max_groups * (sizeof(uint64_t) + sizeof(size_t) + num_aggregates * sizeof(AggregateState));
+    }
+
+    void reserveGroups(size_t max_groups) {
+        hashes.reserve(max_groups);
+        rows.reserve(max_groups);
+        states.reserve(max_groups * num_aggregates);
+    }
+
+    size_t groupCount() const { return hashes.size(); }
+
+    // Returns the state block of the group of `row`, creating it if needed.
+    AggregateState* findOrInsert(uint64_t hash, size_t row, const TableData& input,
+                                 const std::vector<size_t>& keys, bool& inserted) {
+        size_t pos = static_cast<size_t>(hash) & mask;
+        while (true) {
+            Slot& slot = slots[pos];
+            if (slot.group == EMPTY_SLOT) {
+                slot.hash = hash;
+                slot.group = static_cast<uint32_t>(hashes.size());
+                hashes.push_back(hash);
+                rows.push_back(row);
+                states.resize(states.size() + num_aggregates);
+                inserted = true;
+                return &states[static_cast<size_t>(slot.group) * num_aggregates];
+            }
+            if (slot.hash == hash && rowsEqual(input, keys, rows[slot.group], row)) {
+                inserted = false;
+                return &states[static_cast<size_t>(slot.group) * num_aggregates];
+            }
+            pos = (pos + 1) & mask;
+        }
+    }
+
+    void clear() {
+        std::fill(slots.begin(), slots.end(), Slot{0, EMPTY_SLOT});
+        hashes.clear();
+        rows.clear();
+        states.clear();
+    }
+
+private:
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+    struct Slot {
+        uint64_t hash;
+        uint32_t group;
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+    size_t num_aggregates;
+};
+
+// Integer SUM that reports overflow instead of wrapping.
+int64_t addSum(int64_t a, int64_t b) {
+    int64_t result;
+    if (__builtin_add_overflow(a, b, &result)) {
+        throw std::runtime_error("SUM overflow");
+    }
+    return result;
+}
+
+void updateState(AggregateState& state, const AggregateSpec& spec,
+                 const ColumnData* column, size_t row) {
+    using Function = AggregateExpression::Function;
+    switch (spec.function) {
+        case Function::COUNT:
+            state.count++;
+            return;
+        case Function::SUM:
+            if (column->kind() == StorageKind::FLOAT) state.float_value += column->floatAt(row);
+            else state.int_value = addSum(state.int_value, column->integerAt(row));
+            return;
+        case Function::AVG:
+            state.float_value += column->numericAt(row);
+            state.count++;
+            return;
+        case Function::MIN:
+        case Function::MAX: {
+            bool is_min = spec.function == Function::MIN;
+            switch (column->kind()) {
+                case StorageKind::INTEGER: {
+                    int64_t v = column->integerAt(row);
+                    if (!state.has_value || (is_min ? v < state.int_value : v > state.int_value)) {
+                        state.int_value = v;
+                    }
+                    break;
+                }
+                case StorageKind::FLOAT: {
+                    double v = column->floatAt(row);
+                    if (!state.has_value || (is_min ? v < state.float_value : v > state.float_value)) {
+                        state.float_value = v;
+                    }
+                    break;
+                }
+                case StorageKind::STRING: {
+                    const std::string& v = column->stringAt(row);
+                    if (!state.has_value ||
+                        (is_min ? v < column->stringAt(state.row) : v > column->stringAt(state.row))) {
+                        state.row = row;
+                    }
+                    break;
+                }
+            }
+            state.has_value = true;
+            return;
+        }
+    }
+}
+
+void mergeState(AggregateState& into, const AggregateState& from, const AggregateSpec& spec,
+                const ColumnData* column) {
+    using Function = AggregateExpression::Function;
+    switch (spec.function) {
+        case Function::COUNT:
+        case Function::SUM:
+        case Function::AVG:
+            into.count += from.count;
+            into.int_value = addSum(into.int_value, from.int_value);
+            into.float_value += from.float_value;
+            return;
+        case Function::MIN:
+        case Function::MAX: {
+            if (!from.has_value) return;
+            if (!into.has_value) {
+                into = from;
+                return;
+            }
+            bool is_min = spec.function == Function::MIN;
+            switch (column->kind()) {
+                case StorageKind::INTEGER:
+                    if (is_min ? from.int_value < into.int_value : from.int_value > into.int_value) {
+                        into.int_value = from.int_value;
+                    }
+                    break;
+                case StorageKind::FLOAT:
+                    if (is_min ? from.float_value < into.float_value : from.float_value > into.float_value) {
+                        into.float_value = from.float_value;
+                    }
+                    break;
+                case StorageKind::STRING: {
+                    const std::string& a = column->stringAt(from.row);
+                    const std::string& b = column->stringAt(into.row);
+                    if (is_min ? a < b : a > b) {
+                        into.row = from.row;
+                    }
+                    break;
+                }
+            }
+            return;
+        }
+    }
+}
+
+// No NULLs yet: aggregates over an empty input produce zero values.
+void emitState(ColumnData& out, const AggregateState& state, const AggregateSpec& spec,
+               const ColumnData* column) {
+    using Function = AggregateExpression::Function;
+    switch (spec.function) {
+        case Function::COUNT:
+            out.appendInteger(state.count);
+            return;
+        case Function::SUM:
+            if (out.kind() == StorageKind::FLOAT) out.appendFloat(state.float_value);
+            else out.appendInteger(state.int_value);
+            return;
+        case Function::AVG:
+            out.appendFloat(state.count == 0 ? 0.0 : state.float_value / static_cast<double>(state.count));
+            return;
+        case Function::MIN:
+        case Function::MAX:
+            switch (out.kind()) {
+                case StorageKind::INTEGER: out.appendInteger(state.int_value); break;
+                case StorageKind::FLOAT: out.appendFloat(state.float_value); break;
+                case StorageKind::STRING:
+                    out.appendString(state.has_value ? column->stringAt(state.row) : std::string());
+                    break;
+            }
+            return;
+    }
+}
+
+} // namespace
+
+HashAggregator::HashAggregator(const AggregatePlan& plan, AggregateOptions options)
+    : plan(plan), options(options) {}
+
+TableData HashAggregator::execute(const TableData& input) const {
+    const size_t num_threads = resolveThreadCount(options.num_threads);
+    const size_t num_aggregates = plan.aggregates.size();
+    const std::vector<size_t>& keys = plan.group_columns;
+    
+    size_t radix_bits = options.radix_bits;
+    if (radix_bits == 0) {
+        while ((size_t{1} << radix_bits) < num_threads * 4) radix_bits++;
+    }
+    const size_t num_partitions = size_t{1} << radix_bits;
+    auto partitionOf = [&](uint64_t hash) {
+        return radix_bits == 0 ? size_t{0} : static_cast<size_t>(hash >> (64 - radix_bits));
+    };
+    
+    std::vector<const ColumnData*> agg_columns(num_aggregates, nullptr);
+    for (size_t a = 0; a < num_aggregates; ++a) {
+        if (plan.aggregates[a].has_argument) {
+            agg_columns[a] = &input.columns[plan.aggregates[a].column_id];
+        }
+    }
+    
+    // Phase 1: thread-local pre-aggregation, spilling into radix partitions.
+    // The largest power of two of groups whose table fits local_table_bytes.
+    size_t max_local_groups = 16;
+    while (GroupTable::bytesFor(max_local_groups * 2, num_aggregates) <= options.local_table_bytes) {
+        max_local_groups *= 2;
+    }
+    const size_t num_rows = input.rowCount();
+    std::vector<std::vector<PartialGroups>> spilled(num_threads, std::vector<PartialGroups>(num_partitions));
+    
+    runParallel(num_threads, [&](size_t t) {
+        GroupTable local(max_local_groups, num_aggregates);
+        local.reserveGroups(max_local_groups);
+        std::vector<PartialGroups>& partitions = spilled[t];
+        auto spill = [&] {
+            for (size_t g = 0; g < local.groupCount(); ++g) {
+                PartialGroups& part = partitions[partitionOf(local.hashes[g])];
+                part.hashes.push_back(local.hashes[g]);
+                part.rows.push_back(local.rows[g]);
+                part.states.insert(part.states.end(),
+                                   local.states.begin() + static_cast<std::ptrdiff_t>(g * num_aggregates),
+                                   local.states.begin() + static_cast<std::ptrdiff_t>((g + 1) * num_aggregates));
+            }
+            local.clear();
+        };
+        
+        const size_t end = sliceBegin(num_rows, num_threads, t + 1);
+        for (size_t row = sliceBegin(num_rows, num_threads, t); row < end; ++row) {
+            if (local.groupCount() == max_local_groups) {
+                spill();
+            }
+            uint64_t hash = hashRow(input, keys, row);
+            bool inserted;
+            AggregateState* states = local.findOrInsert(hash, row, input, keys, inserted);
+            for (size_t a = 0; a < num_aggregates; ++a) {
+                updateState(states[a], plan.aggregates[a], agg_columns[a], row);
+            }
+        }
+        spill();
+    });
+    
+    // Phase 2: merge each partition independently.
+    std::vector<GroupTable> merged;
+    merged.reserve(num_partitions);
+    for (size_t p = 0; p < num_partitions; ++p) {
+        size_t total = 0;
+        for (size_t t = 0; t < num_threads; ++t) {
+            total += spilled[t][p].hashes.size();
+        }
+        merged.emplace_back(std::max<size_t>(16, total), num_aggregates);
+    }
+    std::atomic<size_t> next_partition{0};
+    runParallel(std::min(num_threads, num_partitions), [&](size_t) {
+        for (size_t p = next_partition++; p < num_partitions; p = next_partition++) {
+            GroupTable& table = merged[p];
+            for (size_t t = 0; t < num_threads; ++t) {
+                const PartialGroups& part = spilled[t][p];
+                for (size_t i = 0; i < part.hashes.size(); ++i) {
+                    bool inserted;
+                    AggregateState* states = table.findOrInsert(part.hashes[i], part.rows[i], input, keys, inserted);
+                    const AggregateState* incoming = &part.states[i * num_aggregates];
+                    for (size_t a = 0; a < num_aggregates; ++a) {
+                        if (inserted) states[a] = incoming[a];
+                        else mergeState(states[a], incoming[a], plan.aggregates[a], agg_columns[a]);
+                    }
+                }
+                std::vector<PartialGroups>& source = spilled[t];
+                source[p] = PartialGroups();
+            }
+        }
+    });
+    
+    // Materialize in select-list order.
+    std::vector<DataType> output_types;
+    for (const auto& out : plan.outputs) {
+        output_types.push_back(out.type);
+    }
+    TableData result(output_types);
+    auto emitGroup = [&](const GroupTable* table, size_t g, const AggregateState* states) {
+        for (size_t i = 0; i < plan.outputs.size(); ++i) {
+            const auto& out = plan.outputs[i];
+            if (out.is_aggregate) {
+                emitState(result.columns[i], states[out.index], plan.aggregates[out.index],
+                          agg_columns[out.index]);
+            } else {
+                result.columns[i].appendFrom(input.columns[keys[out.index]], table->rows[g]);
+            }
+        }
+    };
+    for (const GroupTable& table : merged) {
+        for (size_t g = 0; g < table.groupCount(); ++g) {
+            emitGroup(&table, g, &table.states[g * num_aggregates]);
+        }
+    }
+    if (keys.empty() && result.rowCount() == 0) {
+        // Aggregates without GROUP BY always produce one row.
+        std::vector<AggregateState> initial(num_aggregates);
+        emitGroup(nullptr, 0, initial.data());
+    }
+    return result;
+}
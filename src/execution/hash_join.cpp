@@ -0,0 +1,211 @@
+#include "execution/hash_join.h"
+#include "execution/hashing.h"
+#include "execution/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t EMPTY_ROW = UINT32_MAX;
+// Entries per partition that keep its table (2 slots per entry) within L2.
+constexpr size_t TARGET_PARTITION_ENTRIES = 16 * 1024;
+constexpr size_t MAX_RADIX_BITS = 16;
+
+// Bits 24..55 of the hash: disjoint from the slot index (low bits) and the
+// partition number (high bits).
+uint32_t hashTag(uint64_t hash) {
+    return static_cast<uint32_t>(hash >> 24);
+}
+
+} // namespace
+
+HashJoin::HashJoin(JoinOptions options)
+    : options(options), build_column(nullptr), radix_bits(0), filtered_rows(0) {}
+
+size_t HashJoin::partitionOf(uint64_t hash) const {
+    return radix_bits == 0 ? 0 : static_cast<size_t>(hash >> (64 - radix_bits));
+}
+
+void HashJoin::build(const ColumnData& build_keys) {
+    const size_t num_rows = build_keys.size();
+    if (num_rows >= EMPTY_ROW) {
+        throw std::runtime_error("Hash join build side is too large");
+    }
+    const size_t num_threads = resolveThreadCount(options.num_threads);
+    build_column = &build_keys;
+    
+    radix_bits = options.radix_bits;
+    if (radix_bits == 0) {
+        while ((num_rows >> radix_bits) > TARGET_PARTITION_ENTRIES && radix_bits < MAX_RADIX_BITS) {
+            radix_bits++;
+        }
+    }
+    const size_t num_partitions = size_t{1} << radix_bits;
+    bloom = options.use_bloom_filter ? std::make_unique<BloomFilter>(num_rows) : nullptr;
+    
+    // Pass 1: per-thread partition histograms (and the Bloom filter).
+    std::vector<std::vector<size_t>> counts(num_threads, std::vector<size_t>(num_partitions, 0));
+    runParallel(num_threads, [&](size_t t) {
+        std::vector<size_t>& local = counts[t];
+        const size_t end = sliceBegin(num_rows, num_threads, t + 1);
+        for (size_t row = sliceBegin(num_rows, num_threads, t); row < end; ++row) {
+            uint64_t hash = hashValue(build_keys, row);
+            local[partitionOf(hash)]++;
+            if (bloom) bloom->insert(hash);
+        }
+    });
+    
+    // Exclusive prefix sums give every thread a private write cursor per
+    // partition in one contiguous scatter buffer.
+    std::vector<size_t> partition_start(num_partitions + 1, 0);
+    size_t offset = 0;
+    for (size_t p = 0; p < num_partitions; ++p) {
+        partition_start[p] = offset;
+        for (size_t t = 0; t < num_threads; ++t) {
+            size_t count = counts[t][p];
+            counts[t][p] = offset;
+            offset += count;
+        }
+    }
+    partition_start[num_partitions] = offset;
+    
+    // Pass 2: scatter (hash tag, row) into partitions.
+    std::vector<uint64_t> scattered_hashes(num_rows);
+    std::vector<uint32_t> scattered_rows(num_rows);
+    runParallel(num_threads, [&](size_t t) {
+        std::vector<size_t>& cursor = counts[t];
+        const size_t end = sliceBegin(num_rows, num_threads, t + 1);
+        for (size_t row = sliceBegin(num_rows, num_threads, t); row < end; ++row) {
+            uint64_t hash = hashValue(build_keys, row);
+            size_t pos = cursor[partitionOf(hash)]++;
+            scattered_hashes[pos] = hash;
+            scattered_rows[pos] = static_cast<uint32_t>(row);
+        }
+    });
+    
+    // Pass 3: one linear-probing table per partition.
+    partitions.assign(num_partitions, PartitionTable());
+    std::atomic<size_t> next_partition{0};
+    runParallel(std::min(num_threads, num_partitions), [&](size_t) {
+        for (size_t p = next_partition++; p < num_partitions; p = next_partition++) {
+            size_t begin = partition_start[p];
+            size_t end = partition_start[p + 1];
+            if (begin == end) continue;
+            PartitionTable& table = partitions[p];
+            table.slots.assign(nextPowerOfTwo(2 * (end - begin)), Entry{0, EMPTY_ROW});
+            table.mask = table.slots.size() - 1;
+            for (size_t i = begin; i < end; ++i) {
+                size_t pos = static_cast<size_t>(scattered_hashes[i]) & table.mask;
+                while (table.slots[pos].row != EMPTY_ROW) {
+                    pos = (pos + 1) & table.mask;
+                }
+                table.slots[pos] = Entry{hashTag(scattered_hashes[i]), scattered_rows[i]};
+            }
+        }
+    });
+}
+
+void HashJoin::checkProbeKeys(const ColumnData& probe_keys) const {
+    if (build_column == nullptr) {
+        throw std::runtime_error("HashJoin::probe called before build");
+    }
+    if (probe_keys.kind() != build_column->kind()) {
+        throw std::runtime_error("Join key types differ between build and probe side");
+    }
+}
+
+std::vector<size_t> HashJoin::filterProbeRows(const ColumnData& probe_keys) const {
+    checkProbeKeys(probe_keys);
+    const size_t num_rows = probe_keys.size();
+    filtered_rows = 0;
+    std::vector<size_t> all_rows;
+    if (!bloom) {
+        all_rows.resize(num_rows);
+        for (size_t row = 0; row < num_rows; ++row) all_rows[row] = row;
+        return all_rows;
+    }
+    
+    const size_t num_threads = resolveThreadCount(options.num_threads);
+    std::vector<std::vector<size_t>> selected(num_threads);
+    runParallel(num_threads, [&](size_t t) {
+        const size_t end = sliceBegin(num_rows, num_threads, t + 1);
+        for (size_t row = sliceBegin(num_rows, num_threads, t); row < end; ++row) {
+            if (bloom->mayContain(hashValue(probe_keys, row))) {
+                selected[t].push_back(row);
+            }
+        }
+    });
+    
+    size_t total = 0;
+    for (const auto& rows : selected) total += rows.size();
+    all_rows.reserve(total);
+    for (const auto& rows : selected) {
+        all_rows.insert(all_rows.end(), rows.begin(), rows.end());
+    }
+    filtered_rows = num_rows - total;
+    return all_rows;
+}
+
+void HashJoin::probe(const ColumnData& probe_keys,
+                     const std::function<void(const JoinBatch&)>& consumer) const {
+    probe(probe_keys, filterProbeRows(probe_keys), consumer);
+}
+
+void HashJoin::probe(const ColumnData& probe_keys, const std::vector<size_t>& rows,
+                     const std::function<void(const JoinBatch&)>& consumer) const {
+    checkProbeKeys(probe_keys);
+    const size_t num_rows = rows.size();
+    const size_t num_threads = resolveThreadCount(options.num_threads);
+    const size_t batch_size = std::max<size_t>(1, options.batch_size);
+    
+    runParallel(num_threads, [&](size_t t) {
+        JoinBatch batch;
+        batch.build_rows.reserve(batch_size);
+        batch.probe_rows.reserve(batch_size);
+        
+        const size_t end = sliceBegin(num_rows, num_threads, t + 1);
+        for (size_t i = sliceBegin(num_rows, num_threads, t); i < end; ++i) {
+            const size_t row = rows[i];
+            uint64_t hash = hashValue(probe_keys, row);
+            const PartitionTable& table = partitions[partitionOf(hash)];
+            if (table.slots.empty()) continue;
+            
+            uint32_t tag = hashTag(hash);
+            size_t pos = static_cast<size_t>(hash) & table.mask;
+            while (table.slots[pos].row != EMPTY_ROW) {
+                const Entry& entry = table.slots[pos];
+                if (entry.tag == tag && valuesEqual(*build_column, entry.row, probe_keys, row)) {
+                    batch.build_rows.push_back(entry.row);
+                    batch.probe_rows.push_back(row);
+                    if (batch.size() == batch_size) {
+                        consumer(batch);
+                        batch.build_rows.clear();
+                        batch.probe_rows.clear();
+                    }
+                }
+                pos = (pos + 1) & table.mask;
+            }
+        }
+        if (batch.size() > 0) {
+            consumer(batch);
+        }
+    });
+}
+
+const BloomFilter* HashJoin::bloomFilter() const {
+    return bloom.get();
+}
+
+size_t HashJoin::partitionCount() const {
+    return partitions.size();
+}
+
+uint64_t HashJoin::filteredProbeRows() const {
+    return filtered_rows.load();
+}
@@ -0,0 +1,471 @@
+#include "execution/sort.h"
+#include "execution/parallel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t SIGN_BIT = uint64_t{1} << 63;
+constexpr size_t SPILL_BUFFER_SIZE = 1 << 20;
+constexpr size_t MIN_SPILL_BUFFER_SIZE = 4096;
+
+void appendBigEndian(std::string& out, uint64_t value) {
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out += static_cast<char>((value >> shift) & 0xFF);
+    }
+}
+
+// Byte string whose lexicographic (unsigned) order is the sort order.
+// Integers flip the sign bit; floats flip the sign bit of positives and all
+// bits of negatives; strings escape 0x00 as 0x00 0x01 and end with 0x00 0x00
+// so that prefixes sort first. DESC keys are bitwise inverted. The row id
+// goes last as a tie breaker.
+void encodeKey(std::string& out, const TableData& input, const std::vector<SortKey>& keys, size_t row) {
+    out.clear();
+    for (const SortKey& key : keys) {
+        size_t start = out.size();
+        const ColumnData& column = input.columns[key.column_id];
+        switch (column.kind()) {
+            case StorageKind::INTEGER:
+                appendBigEndian(out, static_cast<uint64_t>(column.integerAt(row)) ^ SIGN_BIT);
+                break;
+            case StorageKind::FLOAT: {
+                double value = column.floatAt(row);
+                if (value == 0.0) value = 0.0;
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                appendBigEndian(out, (bits & SIGN_BIT) != 0 ? ~bits : bits | SIGN_BIT);
+                break;
+            }
+            case StorageKind::STRING:
+                for (char c : column.stringAt(row)) {
+                    out += c;
+                    if (c == '\0') out += '\x01';
+                }
+                out += '\0';
+                out += '\0';
+                break;
+        }
+        if (key.descending) {
+            for (size_t i = start; i < out.size(); ++i) {
+                out[i] = static_cast<char>(~out[i]);
+            }
+        }
+    }
+    appendBigEndian(out, row);
+}
+
+size_t decodeRow(std::string_view key) {
+    uint64_t row = 0;
+    for (size_t i = key.size() - 8; i < key.size(); ++i) {
+        row = (row << 8) | static_cast<unsigned char>(key[i]);
+    }
+    return static_cast<size_t>(row);
+}
+
+struct FileCloser {
+    void operator()(FILE* file) const { std::fclose(file); }
+};
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+// Anonymous temp file, unlinked on creation so nothing is left behind.
+FilePtr openTempFile(const std::string& directory) {
+    std::string dir = directory.empty() ? std::filesystem::temp_directory_path().string() : directory;
+    std::string path = dir + "/db_sort_XXXXXX";
+    int fd = mkstemp(path.data());
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create sort spill file in " + dir);
+    }
+    unlink(path.c_str());
+    FILE* file = fdopen(fd, "w+b");
+    if (file == nullptr) {
+        close(fd);
+        throw std::runtime_error("Cannot open sort spill file");
+    }
+    return FilePtr(file);
+}
+
+// Sorted keys in an anonymous temp file as [u32 length][bytes] records. The
+// stdio buffer is sized to the run, owned here and installed before any I/O.
+class SpilledRun {
+public:
+    SpilledRun(const std::string& directory, size_t expected_bytes)
+        : buffer_size(std::clamp(expected_bytes, MIN_SPILL_BUFFER_SIZE, SPILL_BUFFER_SIZE)),
+          buffer(new char[buffer_size]), file(openTempFile(directory)), bytes(0) {
+        std::setvbuf(file.get(), buffer.get(), _IOFBF, buffer_size);
+    }
+
+    SpilledRun(SpilledRun&&) = default;
+    SpilledRun& operator=(SpilledRun&& other) noexcept {
+        file.reset();  // close the stream while its buffer is still alive
+        buffer_size = other.buffer_size;
+        buffer = std::move(other.buffer);
+        file = std::move(other.file);
+        bytes = other.bytes;
+        return *this;
+    }
+
+    void write(std::string_view key) {
+        auto length = static_cast<uint32_t>(key.size());
+        if (std::fwrite(&length, sizeof(length), 1, file.get()) != 1 ||
+            std::fwrite(key.data(), 1, length, file.get()) != length) {
+            throw std::runtime_error("Failed to write sort spill file");
+        }
+        bytes += sizeof(length) + length;
+    }
+
+    // Flushes the written keys and rewinds for reading.
+    void finish() {
+        if (std::fflush(file.get()) != 0) {
+            throw std::runtime_error("Failed to write sort spill file");
+        }
+        std::rewind(file.get());
+    }
+
+    FILE* get() const { return file.get(); }
+    size_t size() const { return bytes; }
+
+private:
+    size_t buffer_size;
+    std::unique_ptr<char[]> buffer;  // declared before file, so it outlives the stream
+    FilePtr file;
+    size_t bytes;
+};
+
+// Keys of one run, stored back to back in an arena.
+class MemoryRun {
+public:
+    void add(const std::string& key) {
+        refs.push_back({arena.size(), key.size()});
+        arena += key;
+    }
+
+    size_t bytes() const { return arena.size() + refs.size() * sizeof(KeyRef); }
+    bool empty() const { return refs.empty(); }
+    size_t size() const { return refs.size(); }
+
+    std::string_view key(size_t i) const {
+        return std::string_view(arena).substr(refs[i].offset, refs[i].length);
+    }
+
+    void sort() {
+        std::sort(refs.begin(), refs.end(), [this](const KeyRef& a, const KeyRef& b) {
+            return std::string_view(arena).substr(a.offset, a.length) <
+                   std::string_view(arena).substr(b.offset, b.length);
+        });
+    }
+
+    SpilledRun spill(const std::string& directory) const {
+        SpilledRun file(directory, arena.size() + refs.size() * sizeof(uint32_t));
+        for (size_t i = 0; i < refs.size(); ++i) {
+            file.write(key(i));
+        }
+        file.finish();
+        return file;
+    }
+
+private:
+    struct KeyRef {
+        size_t offset;
+        size_t length;
+    };
+    std::string arena;
+    std::vector<KeyRef> refs;
+};
+
+class RunCursor {
+public:
+    virtual ~RunCursor() = default;
+    virtual bool valid() const = 0;
+    virtual std::string_view key() const = 0;
+    virtual void next() = 0;
+};
+
+class MemoryRunCursor : public RunCursor {
+public:
+    explicit MemoryRunCursor(const MemoryRun& run) : run(run), pos(0) {}
+
+    bool valid() const override { return pos < run.size(); }
+    std::string_view key() const override { return run.key(pos); }
+    void next() override { pos++; }
+
+private:
+    const MemoryRun& run;
+    size_t pos;
+};
+
+class FileRunCursor : public RunCursor {
+public:
+    explicit FileRunCursor(FILE* file) : file(file), has_key(false) {
+        next();
+    }
+
+    bool valid() const override { return has_key; }
+    std::string_view key() const override { return current; }
+    void next() override {
+        uint32_t length;
+        if (std::fread(&length, sizeof(length), 1, file) != 1) {
+            has_key = false;
+            return;
+        }
+        current.resize(length);
+        if (std::fread(current.data(), 1, length, file) != length) {
+            throw std::runtime_error("Truncated sort spill file");
+        }
+        has_key = true;
+    }
+
+private:
+    FILE* file;
+    std::string current;
+    bool has_key;
+};
+
+// Tournament tree of losers over k sorted cursors: each pop costs
+// log2(k) comparisons along a single leaf-to-root path.
+class LoserTree {
+public:
+    explicit LoserTree(std::vector<RunCursor*> inputs)
+        : sources(std::move(inputs)), k(sources.size()), tree(k, k) {
+        // Slot value k is a sentinel that beats everything.
+        for (size_t i = k; i-- > 0;) {
+            adjust(i);
+        }
+    }
+
+    bool empty() const { return k == 0 || !sources[tree[0]]->valid(); }
+    RunCursor& top() { return *sources[tree[0]]; }
+
+    void pop() {
+        size_t winner = tree[0];
+        sources[winner]->next();
+        adjust(winner);
+    }
+
+private:
+    std::vector<RunCursor*> sources;
+    size_t k;
+    std::vector<size_t> tree;
+
+    bool beats(size_t a, size_t b) const {
+        if (a == k) return true;
+        if (b == k) return false;
+        if (!sources[a]->valid()) return false;
+        if (!sources[b]->valid()) return true;
+        return sources[a]->key() < sources[b]->key();
+    }
+
+    void adjust(size_t leaf) {
+        size_t winner = leaf;
+        for (size_t node = (leaf + k) / 2; node > 0; node /= 2) {
+            if (beats(tree[node], winner)) {
+                std::swap(winner, tree[node]);
+            }
+        }
+        tree[0] = winner;
+    }
+};
+
+// Merges runs[first, last) into one new spilled run.
+SpilledRun mergeSpilled(const std::vector<SpilledRun>& runs, size_t first, size_t last,
+                        const std::string& directory) {
+    size_t bytes = 0;
+    std::vector<std::unique_ptr<RunCursor>> cursors;
+    std::vector<RunCursor*> inputs;
+    for (size_t i = first; i < last; ++i) {
+        bytes += runs[i].size();
+        cursors.push_back(std::make_unique<FileRunCursor>(runs[i].get()));
+        inputs.push_back(cursors.back().get());
+    }
+    LoserTree tree(std::move(inputs));
+    SpilledRun merged(directory, bytes);
+    while (!tree.empty()) {
+        merged.write(tree.top().key());
+        tree.pop();
+    }
+    merged.finish();
+    return merged;
+}
+
+} // namespace
+
+Sorter::Sorter(const SortPlan& plan, SortOptions options)
+    : plan(plan), options(std::move(options)), spilled_runs(0) {}
+
+size_t Sorter::spilledRunCount() const {
+    return spilled_runs.load();
+}
+
+std::vector<size_t> Sorter::sortedRows(const TableData& input) const {
+    const size_t num_rows = input.rowCount();
+    const size_t limit = std::min(num_rows, plan.limit.value_or(num_rows));
+    const size_t num_threads = std::min(resolveThreadCount(options.num_threads),
+                                        std::max<size_t>(1, num_rows));
+    spilled_runs = 0;
+    
+    if (limit == 0) {
+        return {};
+    }
+    if (plan.keys.empty()) {
+        std::vector<size_t> rows(limit);
+        for (size_t i = 0; i < limit; ++i) rows[i] = i;
+        return rows;
+    }
+    if (plan.limit && limit <= options.top_k_threshold && limit < num_rows) {
+        return topK(input, limit, num_threads);
+    }
+    return externalSort(input, limit, num_threads);
+}
+
+std::vector<size_t> Sorter::topK(const TableData& input, size_t k, size_t num_threads) const {
+    const size_t num_rows = input.rowCount();
+    std::vector<std::vector<std::string>> candidates(num_threads);
+    
+    runParallel(num_threads, [&](size_t t) {
+        // Max-heap of the k smallest keys seen so far.
+        std::priority_queue<std::string> heap;
+        std::string key;
+        const size_t end = sliceBegin(num_rows, num_threads, t + 1);
+        for (size_t row = sliceBegin(num_rows, num_threads, t); row < end; ++row) {
+            encodeKey(key, input, plan.keys, row);
+            if (heap.size() < k) {
+                heap.push(key);
+            } else if (key < heap.top()) {
+                heap.pop();
+                heap.push(key);
+            }
+        }
+        candidates[t].reserve(heap.size());
+        while (!heap.empty()) {
+            candidates[t].push_back(heap.top());
+            heap.pop();
+        }
+    });
+    
+    std::vector<std::string> merged;
+    for (auto& keys : candidates) {
+        merged.insert(merged.end(), std::make_move_iterator(keys.begin()),
+                      std::make_move_iterator(keys.end()));
+    }
+    std::sort(merged.begin(), merged.end());
+    
+    std::vector<size_t> rows;
+    rows.reserve(k);
+    for (size_t i = 0; i < k && i < merged.size(); ++i) {
+        rows.push_back(decodeRow(merged[i]));
+    }
+    return rows;
+}
+
+std::vector<size_t> Sorter::externalSort(const TableData& input, size_t limit, size_t num_threads) const {
+    const size_t num_rows = input.rowCount();
+    const size_t thread_budget = std::max<size_t>(1, options.memory_budget_bytes / num_threads);
+    const size_t fan_in = std::max<size_t>(2, options.max_merge_fan_in);
+    const size_t thread_fan_in = std::max<size_t>(2, fan_in / num_threads);
+    std::vector<std::vector<MemoryRun>> memory_runs(num_threads);
+    // Spilled runs per thread and merge level: whenever a level fills up,
+    // its runs are merged into one run on the next level, which keeps the
+    // number of open spill files logarithmic in the input.
+    std::vector<std::vector<std::vector<SpilledRun>>> spilled(num_threads);
+    
+    // Run generation: sort budget-sized runs per thread, spilling full ones.
+    runParallel(num_threads, [&](size_t t) {
+        MemoryRun run;
+        std::string key;
+        auto& levels = spilled[t];
+        const size_t end = sliceBegin(num_rows, num_threads, t + 1);
+        for (size_t row = sliceBegin(num_rows, num_threads, t); row < end; ++row) {
+            encodeKey(key, input, plan.keys, row);
+            run.add(key);
+            if (run.bytes() >= thread_budget) {
+                run.sort();
+                SpilledRun file = run.spill(options.temp_directory);
+                run = MemoryRun();
+                spilled_runs++;
+                for (size_t level = 0;; ++level) {
+                    if (level == levels.size()) levels.emplace_back();
+                    levels[level].push_back(std::move(file));
+                    if (levels[level].size() < thread_fan_in) break;
+                    file = mergeSpilled(levels[level], 0, levels[level].size(), options.temp_directory);
+                    levels[level].clear();
+                }
+            }
+        }
+        if (!run.empty()) {
+            run.sort();
+            memory_runs[t].push_back(std::move(run));
+        }
+    });
+    
+    // Merge spilled runs in groups, oldest first, until the final merge is
+    // within the fan-in.
+    std::vector<MemoryRun> in_memory;
+    std::vector<SpilledRun> on_disk;
+    for (size_t t = 0; t < num_threads; ++t) {
+        for (MemoryRun& run : memory_runs[t]) {
+            in_memory.push_back(std::move(run));
+        }
+        for (auto& level : spilled[t]) {
+            for (SpilledRun& file : level) {
+                on_disk.push_back(std::move(file));
+            }
+        }
+    }
+    const size_t max_on_disk = fan_in > in_memory.size() ? fan_in - in_memory.size() : 1;
+    while (on_disk.size() > max_on_disk) {
+        const size_t group = std::min(fan_in, on_disk.size() - max_on_disk + 1);
+        SpilledRun merged = mergeSpilled(on_disk, 0, group, options.temp_directory);
+        on_disk.erase(on_disk.begin(), on_disk.begin() + static_cast<std::ptrdiff_t>(group));
+        on_disk.push_back(std::move(merged));
+    }
+    
+    std::vector<std::unique_ptr<RunCursor>> cursors;
+    for (const MemoryRun& run : in_memory) {
+        cursors.push_back(std::make_unique<MemoryRunCursor>(run));
+    }
+    for (const SpilledRun& file : on_disk) {
+        cursors.push_back(std::make_unique<FileRunCursor>(file.get()));
+    }
+    
+    std::vector<RunCursor*> inputs;
+    for (auto& cursor : cursors) {
+        inputs.push_back(cursor.get());
+    }
+    LoserTree tree(std::move(inputs));
+    
+    std::vector<size_t> rows;
+    rows.reserve(limit);
+    while (rows.size() < limit && !tree.empty()) {
+        rows.push_back(decodeRow(tree.top().key()));
+        tree.pop();
+    }
+    return rows;
+}
+
+TableData Sorter::execute(const TableData& input) const {
+    std::vector<size_t> rows = sortedRows(input);
+    TableData result;
+    result.columns.reserve(plan.outputs.size());
+    for (const SortPlan::OutputColumn& output : plan.outputs) {
+        const ColumnData& column = input.columns[output.column_id];
+        ColumnData sorted(column.type());
+        sorted.reserve(rows.size());
+        for (size_t row : rows) {
+            sorted.appendFrom(column, row);
+        }
+        result.columns.push_back(std::move(sorted));
+    }
+    return result;
+}
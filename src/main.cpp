@@ -1,10 +1,89 @@
+#include "common/stats.h"
 #include "parser/lexer.h"
 #include "parser/parser.h"
 #include <iostream>
 #include <string>
 
-int main() {
+#ifdef DB_HAS_SERVER
+#include "server/server.h"
+#include <csignal>
+#include <exception>
+
+namespace {
+
+Server* active_server = nullptr;
+
+void handleShutdownSignal(int) {
+    if (active_server != nullptr) {
+        active_server->stop();
+    }
+}
+
+int runServer(const ServerConfig& config) {
+    try {
+        Server server(config);
+        server.start();
+        active_server = &server;
+        std::signal(SIGINT, handleShutdownSignal);
+        std::signal(SIGTERM, handleShutdownSignal);
+        std::cout << "Listening on " << config.host << ":" << server.port();
+        if (!config.unix_socket_path.empty()) {
+            std::cout << " and " << config.unix_socket_path;
+        }
+        std::cout << "\n";
+        server.run();
+        active_server = nullptr;
+    } catch (const std::exception& e) {
+        std::cerr << "Server error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+#endif
+
+int main(int argc, char** argv) {
     std::string sql = "SELECT name from USERS";
+#ifdef DB_ENABLE_STATS
+    std::string stats_format;
+#endif
+#ifdef DB_HAS_SERVER
+    bool server_mode = false;
+    ServerConfig server_config;
+#endif
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--stats-json" || arg == "--stats-prometheus") {
+#ifdef DB_ENABLE_STATS
+            stats_format = arg == "--stats-json" ? "json" : "prometheus";
+#else
+            std::cerr << arg << " needs a build with ENABLE_STATS=ON\n";
+            return 1;
+#endif
+#ifdef DB_HAS_SERVER
+        } else if (arg == "--server") {
+            server_mode = true;
+        } else if (arg == "--host" && i + 1 < argc) {
+            server_config.host = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            server_config.port = static_cast<uint16_t>(std::stoi(argv[++i]));
+        } else if (arg == "--unix" && i + 1 < argc) {
+            server_config.unix_socket_path = argv[++i];
+        } else if (arg == "--workers" && i + 1 < argc) {
+            server_config.worker_threads = static_cast<size_t>(std::stoul(argv[++i]));
+#endif
+        } else {
+            sql = arg;
+        }
+    }
+
+#ifdef DB_HAS_SERVER
+    if (server_mode) {
+        return runServer(server_config);
+    }
+#endif
     
     Lexer lexer(sql);
     auto tokens = lexer.tokenize();
@@ -13,6 +92,14 @@ int main() {
     auto ast = parser.parse();
     
     std::cout << "AST: " << ast->toString() << "\n";
+
+#ifdef DB_ENABLE_STATS
+    if (stats_format == "json") {
+        std::cout << Stats::instance().toJson() << "\n";
+    } else if (stats_format == "prometheus") {
+        std::cout << Stats::instance().toPrometheus();
+    }
+#endif
     
     return 0;
-}
\ No newline at end of file
+}
@@ -8,7 +8,13 @@
 ColumnExpression::ColumnExpression(std::string name)
     : column_name(std::move(name)) {}
 
+ColumnExpression::ColumnExpression(std::string table, std::string name)
+    : table_name(std::move(table)), column_name(std::move(name)) {}
+
 std::string ColumnExpression::toString() const {
+    if (!table_name.empty()) {
+        return "Column(" + table_name + "." + column_name + ")";
+    }
     return "Column(" + column_name + ")";
 }
 
@@ -50,6 +56,25 @@ std::string BinaryExpression::operatorToString(Operator op) const {
     return "?";
 }
 
+// AggregateExpression
+AggregateExpression::AggregateExpression(Function f, std::unique_ptr<Expression> arg)
+    : function(f), argument(std::move(arg)) {}
+
+std::string AggregateExpression::toString() const {
+    return functionToString(function) + "(" + (argument ? argument->toString() : "*") + ")";
+}
+
+std::string AggregateExpression::functionToString(Function f) {
+    switch (f) {
+        case Function::COUNT: return "COUNT";
+        case Function::SUM: return "SUM";
+        case Function::MIN: return "MIN";
+        case Function::MAX: return "MAX";
+        case Function::AVG: return "AVG";
+    }
+    return "?";
+}
+
 // SelectStatement
 std::string SelectStatement::toString() const {
     std::string result = "SELECT ";
@@ -58,9 +83,30 @@ std::string SelectStatement::toString() const {
         result += columns[i]->toString();
     }
     result += " FROM " + table_name;
+    for (const auto& join : joins) {
+        result += " JOIN " + join.table_name + " ON " + join.condition->toString();
+    }
     if (where_clause) {
         result += " WHERE " + where_clause->toString();
     }
+    if (!group_by.empty()) {
+        result += " GROUP BY ";
+        for (size_t i = 0; i < group_by.size(); ++i) {
+            if (i > 0) result += ", ";
+            result += group_by[i]->toString();
+        }
+    }
+    if (!order_by.empty()) {
+        result += " ORDER BY ";
+        for (size_t i = 0; i < order_by.size(); ++i) {
+            if (i > 0) result += ", ";
+            result += order_by[i].expression->toString();
+            if (order_by[i].descending) result += " DESC";
+        }
+    }
+    if (limit) {
+        result += " LIMIT " + std::to_string(*limit);
+    }
     return result;
 }
 
@@ -82,4 +128,9 @@ std::string InsertStatement::toString() const {
     }
     result += ")";
     return result;
-}
\ No newline at end of file
+}
+
+// CopyStatement
+std::string CopyStatement::toString() const {
+    return "COPY " + table_name + " FROM '" + file_path + "'";
+}
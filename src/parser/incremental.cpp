@@ -0,0 +1,248 @@
+#include "parser/incremental.h"
+#include "common/stats.h"
+#include "parser/lexer.h"
+#include "parser/parser.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+IncrementalParser::IncrementalParser(std::string sql)
+    : total_size(sql.size()), relexed_tokens(0), reparsed_statements(0) {
+    Lexer lexer(std::string_view(sql), 0);
+    std::vector<Token> tokens = lexer.tokenize();
+    relexed_tokens = tokens.size();
+    appendChunks(sql, std::move(tokens), 0);
+}
+
+void IncrementalParser::applyEdit(const TextEdit& edit) {
+    if (edit.offset > total_size ||
+        edit.removed_length > total_size - edit.offset) {
+        throw std::out_of_range("Edit range is outside the buffer");
+    }
+    moveSplit(chunkIndexAt(edit.offset));
+    
+    // Take the chunk holding the edit, and every chunk the removal reaches,
+    // off the front of `after`. Text and tokens are relative to `base`; old
+    // token positions are in pre-edit coordinates.
+    const size_t base = total_size - after.back().position;
+    std::string text;
+    std::vector<Token> old_tokens;
+    size_t old_size = 0;
+    auto takeChunk = [&] {
+        Chunk& chunk = after.back();
+        for (Token& token : chunk.tokens) {
+            token.position += old_size;
+            old_tokens.push_back(std::move(token));
+        }
+        text += chunk.text;
+        old_size += chunk.text.size();
+        after.pop_back();
+    };
+    
+    const size_t offset = edit.offset - base;
+    const size_t old_edit_end = offset + edit.removed_length;
+    const size_t inserted = edit.inserted_text.size();
+    takeChunk();
+    while (old_size < old_edit_end) {
+        takeChunk();
+    }
+    text.replace(offset, edit.removed_length, edit.inserted_text);
+    // Chunks in `after` keep their distance from the end.
+    total_size = total_size - edit.removed_length + inserted;
+    // Only valid for old positions at or past old_edit_end.
+    auto shifted = [&](size_t old_position) {
+        return old_position - edit.removed_length + inserted;
+    };
+    
+    // A token whose end (its one byte of lookahead) lies before the edit is
+    // unaffected; everything from the first token reaching the edit is relexed.
+    auto first_it = std::partition_point(
+        old_tokens.begin(), old_tokens.end(),
+        [&](const Token& token) { return token.end() < offset; });
+    const size_t first = static_cast<size_t>(first_it - old_tokens.begin());
+    const size_t resume = first == 0 ? 0 : old_tokens[first - 1].end();
+    
+    std::vector<Token> relexed;
+    size_t old_index = first;
+    {
+        DB_STATS_PHASE(Phase::LEX);
+        auto lexer = std::make_unique<Lexer>(std::string_view(text), resume);
+        while (true) {
+            Token token = lexer->nextToken();
+            // A token running into the end of the taken text may continue in
+            // the next chunk, unless it is the ';' closing a chunk.
+            bool at_text_end = token.type == TokenType::END_OF_FILE ||
+                               (token.end() >= text.size() && token.type != TokenType::SEMICOLON);
+            if (at_text_end && !after.empty()) {
+                if (token.type == TokenType::END_OF_FILE && !relexed.empty() &&
+                    relexed.back().type == TokenType::SEMICOLON && relexed.back().end() == text.size()) {
+                    old_index = old_tokens.size();
+                    break;
+                }
+                takeChunk();
+                lexer = std::make_unique<Lexer>(std::string_view(text),
+                                                relexed.empty() ? resume : relexed.back().end());
+                continue;
+            }
+            
+            while (old_index < old_tokens.size() &&
+                   (old_tokens[old_index].position < old_edit_end ||
+                    shifted(old_tokens[old_index].position) < token.position)) {
+                old_index++;
+            }
+            if (old_index < old_tokens.size() &&
+                old_tokens[old_index].position >= old_edit_end &&
+                shifted(old_tokens[old_index].position) == token.position) {
+                break;
+            }
+            bool at_end = token.type == TokenType::END_OF_FILE;
+            relexed.push_back(std::move(token));
+            if (at_end) {
+                old_index = old_tokens.size();
+                break;
+            }
+        }
+        DB_STATS_ADD(Counter::TOKENS, relexed.size());
+    }
+    relexed_tokens = relexed.size();
+    
+    std::vector<Token> tokens;
+    tokens.reserve(first + relexed.size() + (old_tokens.size() - old_index));
+    tokens.insert(tokens.end(), std::make_move_iterator(old_tokens.begin()),
+                  std::make_move_iterator(old_tokens.begin() + static_cast<std::ptrdiff_t>(first)));
+    tokens.insert(tokens.end(), std::make_move_iterator(relexed.begin()),
+                  std::make_move_iterator(relexed.end()));
+    for (size_t i = old_index; i < old_tokens.size(); ++i) {
+        old_tokens[i].position = shifted(old_tokens[i].position);
+        tokens.push_back(std::move(old_tokens[i]));
+    }
+    
+    reparsed_statements = 0;
+    appendChunks(text, std::move(tokens), base);
+}
+
+size_t IncrementalParser::chunkIndexAt(size_t offset) const {
+    const size_t split = after.empty() ? total_size : total_size - after.back().position;
+    if (offset < split || after.empty()) {
+        auto it = std::upper_bound(before.begin(), before.end(), offset,
+                                   [](size_t value, const Chunk& chunk) { return value < chunk.position; });
+        return static_cast<size_t>(it - before.begin()) - 1;
+    }
+    // `after` is ordered by increasing distance from the end.
+    auto it = std::lower_bound(after.begin(), after.end(), total_size - offset,
+                               [](const Chunk& chunk, size_t value) { return chunk.position < value; });
+    return before.size() + static_cast<size_t>(after.end() - it) - 1;
+}
+
+void IncrementalParser::moveSplit(size_t index) {
+    while (before.size() > index) {
+        Chunk chunk = std::move(before.back());
+        before.pop_back();
+        chunk.position = total_size - chunk.position;
+        after.push_back(std::move(chunk));
+    }
+    while (before.size() < index) {
+        Chunk chunk = std::move(after.back());
+        after.pop_back();
+        chunk.position = total_size - chunk.position;
+        before.push_back(std::move(chunk));
+    }
+}
+
+// Cuts `tokens` (relative to `text`, which starts at `base`) into chunks at
+// every ';' and appends them to `before`.
+void IncrementalParser::appendChunks(const std::string& text, std::vector<Token> tokens, size_t base) {
+    size_t first = 0;
+    size_t start = 0;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        const bool last = i + 1 == tokens.size();
+        if (tokens[i].type != TokenType::SEMICOLON && !last) {
+            continue;
+        }
+        const size_t end = last ? text.size() : tokens[i].end();
+        Chunk chunk;
+        chunk.position = base + start;
+        chunk.text = text.substr(start, end - start);
+        chunk.tokens.assign(std::make_move_iterator(tokens.begin() + static_cast<std::ptrdiff_t>(first)),
+                            std::make_move_iterator(tokens.begin() + static_cast<std::ptrdiff_t>(i + 1)));
+        for (Token& token : chunk.tokens) {
+            token.position -= start;
+        }
+        parseChunk(chunk);
+        before.push_back(std::move(chunk));
+        first = i + 1;
+        start = end;
+    }
+}
+
+void IncrementalParser::parseChunk(Chunk& chunk) {
+    chunk.ast.reset();
+    chunk.error.clear();
+    if (chunk.tokens.size() < 2) {
+        return;  // a lone ';' or END_OF_FILE
+    }
+    std::vector<Token> statement_tokens(chunk.tokens.begin(), chunk.tokens.end() - 1);
+    statement_tokens.emplace_back(TokenType::END_OF_FILE, "", statement_tokens.back().end(), 0);
+    
+    try {
+        Parser parser(std::move(statement_tokens));
+        chunk.ast = parser.parse();
+    } catch (const std::runtime_error& e) {
+        chunk.error = e.what();
+    }
+    reparsed_statements++;
+}
+
+template <typename Visit>
+void IncrementalParser::forEachChunk(Visit&& visit) const {
+    for (const Chunk& chunk : before) {
+        visit(chunk, chunk.position);
+    }
+    for (auto it = after.rbegin(); it != after.rend(); ++it) {
+        visit(*it, total_size - it->position);
+    }
+}
+
+std::string IncrementalParser::text() const {
+    std::string result;
+    result.reserve(total_size);
+    forEachChunk([&](const Chunk& chunk, size_t) { result += chunk.text; });
+    return result;
+}
+
+std::vector<Token> IncrementalParser::tokens() const {
+    std::vector<Token> result;
+    forEachChunk([&](const Chunk& chunk, size_t base) {
+        for (const Token& token : chunk.tokens) {
+            result.push_back(token);
+            result.back().position += base;
+        }
+    });
+    return result;
+}
+
+std::vector<ScriptStatement> IncrementalParser::statements() const {
+    std::vector<ScriptStatement> result;
+    size_t index = 0;
+    forEachChunk([&](const Chunk& chunk, size_t) {
+        if (chunk.tokens.size() > 1) {
+            result.push_back({index, index + chunk.tokens.size() - 1, chunk.ast.get(), chunk.error});
+        }
+        index += chunk.tokens.size();
+    });
+    return result;
+}
+
+size_t IncrementalParser::lastRelexedTokenCount() const {
+    return relexed_tokens;
+}
+
+size_t IncrementalParser::lastReparsedStatementCount() const {
+    return reparsed_statements;
+}
@@ -1,4 +1,5 @@
 #include "parser/lexer.h"
+#include "common/stats.h"
 #include "parser/token.h"
 #include <algorithm>
 #include <cctype>
@@ -6,48 +7,55 @@
 #include <string>
 #include <unordered_map>
 
-Lexer::Lexer(const std::string& sql) : input(sql), position(0) {}
+Lexer::Lexer(const std::string& sql)
+    : owned_input(sql), input(owned_input), position(0) {}
+
+Lexer::Lexer(std::string_view sql, size_t start)
+    : input(sql), position(start) {}
 
 std::vector<Token> Lexer::tokenize() {
+    DB_STATS_PHASE(Phase::LEX);
     std::vector<Token> tokens;
     
-    while (position < input.length()) {
-        char current = input[position];
-        
-        if (std::isspace(current) != 0) {
-            position++;
-            continue;
-        }
-        
-        if (std::isdigit(current) != 0) {
-            tokens.push_back(readNumber());
-            continue;
-        }
-        
-        if ((std::isalpha(current) != 0) || current == '_') {
-            tokens.push_back(readIdentifierOrKeyword());
-            continue;
+    while (true) {
+        tokens.push_back(nextToken());
+        if (tokens.back().type == TokenType::END_OF_FILE) {
+            break;
         }
-        
-        if (current == '\'') {
-            tokens.push_back(readString());
-            continue;
-        }
-        
-        tokens.push_back(readOperator());
     }
     
-    tokens.emplace_back(TokenType::END_OF_FILE, "", position);
+    DB_STATS_ADD(Counter::TOKENS, tokens.size());
     return tokens;
 }
 
+Token Lexer::nextToken() {
+    while (position < input.length() && std::isspace(input[position]) != 0) {
+        position++;
+    }
+    if (position >= input.length()) {
+        return Token(TokenType::END_OF_FILE, "", position, 0);
+    }
+    
+    char current = input[position];
+    if (std::isdigit(current) != 0) {
+        return readNumber();
+    }
+    if ((std::isalpha(current) != 0) || current == '_') {
+        return readIdentifierOrKeyword();
+    }
+    if (current == '\'') {
+        return readString();
+    }
+    return readOperator();
+}
+
 Token Lexer::readNumber() {
     size_t start = position;
     while (position < input.length() && 
            ((std::isdigit(input[position]) != 0) || input[position] == '.')) {
         position++;
     }
-    return Token(TokenType::NUMBER, input.substr(start, position - start), start);
+    return Token(TokenType::NUMBER, std::string(input.substr(start, position - start)), start);
 }
 
 Token Lexer::readIdentifierOrKeyword() {
@@ -56,7 +64,7 @@ Token Lexer::readIdentifierOrKeyword() {
            ((std::isalnum(input[position]) != 0) || input[position] == '_')) {
         position++;
     }
-    std::string value = input.substr(start, position - start);
+    std::string value(input.substr(start, position - start));
     TokenType type = getKeywordType(value);
     return Token(type, value, start);
 }
@@ -74,7 +82,7 @@ Token Lexer::readString() {
     if (position < input.length()) { 
         position++;
     }
-    return Token(TokenType::STRING, value, start);
+    return Token(TokenType::STRING, value, start, position - start);
 }
 
 Token Lexer::readOperator() {
@@ -91,6 +99,7 @@ Token Lexer::readOperator() {
         case '+': return Token(TokenType::PLUS, "+", start);
         case '-': return Token(TokenType::MINUS, "-", start);
         case '/': return Token(TokenType::SLASH, "/", start);
+        case '.': return Token(TokenType::DOT, ".", start);
         case '<':
             if (position < input.length() && input[position] == '=') {
                 position++;
@@ -124,7 +133,12 @@ TokenType Lexer::getKeywordType(const std::string& word) {
         {"CREATE", TokenType::CREATE}, {"TABLE", TokenType::TABLE},
         {"DELETE", TokenType::DELETE}, {"UPDATE", TokenType::UPDATE},
         {"SET", TokenType::SET}, {"AND", TokenType::AND},
-        {"OR", TokenType::OR}, {"NOT", TokenType::NOT}
+        {"OR", TokenType::OR}, {"NOT", TokenType::NOT},
+        {"GROUP", TokenType::GROUP}, {"BY", TokenType::BY},
+        {"JOIN", TokenType::JOIN}, {"INNER", TokenType::INNER},
+        {"ON", TokenType::ON}, {"ORDER", TokenType::ORDER},
+        {"ASC", TokenType::ASC}, {"DESC", TokenType::DESC},
+        {"LIMIT", TokenType::LIMIT}, {"COPY", TokenType::COPY}
     };
     
     auto it = keywords.find(upper);
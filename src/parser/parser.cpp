@@ -1,25 +1,41 @@
 #include "parser/parser.h"
+#include "common/stats.h"
 #include "parser/ast.h"
 #include "parser/token.h"
+#include <algorithm>
+#include <cctype>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <vector>
 #include <utility>
 
 Parser::Parser(std::vector<Token> toks)
-    : tokens(std::move(toks)), current(0) {}
+    : tokens(std::move(toks)), current(0), nodes_created(0), depth(0) {}
 
 std::unique_ptr<Statement> Parser::parse() {
+    DB_STATS_PHASE(Phase::PARSE);
+    std::unique_ptr<Statement> stmt;
     if (match(TokenType::SELECT)) {
-        return parseSelect();
-    } if (match(TokenType::INSERT)) {
-        return parseInsert();
+        stmt = parseSelect();
+    } else if (match(TokenType::INSERT)) {
+        stmt = parseInsert();
+    } else if (match(TokenType::COPY)) {
+        stmt = parseCopy();
+    } else {
+        throw std::runtime_error("Expected SELECT, INSERT or COPY statement");
     }
-    throw std::runtime_error("Expected SELECT or INSERT statement");
+    DB_STATS_ADD(Counter::STATEMENTS, 1);
+    DB_STATS_ADD(Counter::AST_NODES, nodes_created);
+    return stmt;
+}
+
+size_t Parser::nodeCount() const {
+    return nodes_created;
 }
 
 std::unique_ptr<SelectStatement> Parser::parseSelect(){
-    auto stmt = std::make_unique<SelectStatement>();
+    auto stmt = makeNode<SelectStatement>();
     stmt->columns = parseColumnList();
     if (!match(TokenType::FROM)) {
         throw std::runtime_error("Expected FROM keyword");
@@ -30,10 +46,66 @@ std::unique_ptr<SelectStatement> Parser::parseSelect(){
     }
     stmt->table_name = advance().value;
     
+    while (match(TokenType::INNER) || check(TokenType::JOIN)) {
+        if (!match(TokenType::JOIN)) {
+            throw std::runtime_error("Expected JOIN after INNER");
+        }
+        JoinClause join;
+        if (peek().type != TokenType::IDENTIFIER) {
+            throw std::runtime_error("Expected table name after JOIN");
+        }
+        join.table_name = advance().value;
+        if (!match(TokenType::ON)) {
+            throw std::runtime_error("Expected ON after JOIN table");
+        }
+        join.condition = parseExpression();
+        stmt->joins.push_back(std::move(join));
+    }
+    
     if (match(TokenType::WHERE)) {
         stmt->where_clause = parseExpression();
     }
     
+    if (match(TokenType::GROUP)) {
+        if (!match(TokenType::BY)) {
+            throw std::runtime_error("Expected BY after GROUP");
+        }
+        do {
+            if (peek().type != TokenType::IDENTIFIER) {
+                throw std::runtime_error("Expected column name in GROUP BY");
+            }
+            stmt->group_by.push_back(parseColumnReference());
+        } while (match(TokenType::COMMA));
+    }
+    
+    if (match(TokenType::ORDER)) {
+        if (!match(TokenType::BY)) {
+            throw std::runtime_error("Expected BY after ORDER");
+        }
+        do {
+            OrderByItem item;
+            item.expression = parsePrimary();
+            if (match(TokenType::DESC)) {
+                item.descending = true;
+            } else {
+                match(TokenType::ASC);
+            }
+            stmt->order_by.push_back(std::move(item));
+        } while (match(TokenType::COMMA));
+    }
+    
+    if (match(TokenType::LIMIT)) {
+        if (peek().type != TokenType::NUMBER ||
+            peek().value.find('.') != std::string::npos) {
+            throw std::runtime_error("Expected integer after LIMIT");
+        }
+        try {
+            stmt->limit = std::stoull(advance().value);
+        } catch (const std::out_of_range&) {
+            throw std::runtime_error("LIMIT value is out of range");
+        }
+    }
+    
     return stmt;
 
 }
@@ -43,9 +115,9 @@ std::vector<std::unique_ptr<Expression>> Parser::parseColumnList() {
     do {
         if (peek().type == TokenType::STAR) {
             advance();
-            columns.push_back(std::make_unique<ColumnExpression>("*"));
+            columns.push_back(makeNode<ColumnExpression>("*"));
         } else if (peek().type == TokenType::IDENTIFIER) {
-            columns.push_back(std::make_unique<ColumnExpression>(advance().value));
+            columns.push_back(parsePrimary());
         } else {
             throw std::runtime_error("Expected column name or *");
         }
@@ -61,7 +133,7 @@ std::unique_ptr<Expression> Parser::parseOr() {
     auto left = parseAnd();
     while (match(TokenType::OR)) {
         auto right = parseAnd();
-        left = std::make_unique<BinaryExpression>(
+        left = makeNode<BinaryExpression>(
             std::move(left), std::move(right), BinaryExpression::Operator::OR
         );
     }
@@ -72,7 +144,7 @@ std::unique_ptr<Expression> Parser::parseAnd() {
     auto left = parseComparison();
     while (match(TokenType::AND)) {
         auto right = parseComparison();
-        left = std::make_unique<BinaryExpression>(
+        left = makeNode<BinaryExpression>(
             std::move(left), std::move(right), BinaryExpression::Operator::AND
         );
     }
@@ -93,22 +165,38 @@ std::unique_ptr<Expression> Parser::parseComparison() {
     else return left;
     
     auto right = parsePrimary();
-    return std::make_unique<BinaryExpression>(std::move(left), std::move(right), op);
+    return makeNode<BinaryExpression>(std::move(left), std::move(right), op);
 }
 
 std::unique_ptr<Expression> Parser::parsePrimary() {
+    // Parenthesised expressions and aggregate arguments recurse back here.
+    struct DepthGuard {
+        size_t& depth;
+        explicit DepthGuard(size_t& d) : depth(d) {
+            if (++depth > MAX_NESTING_DEPTH) {
+                --depth;
+                throw std::runtime_error("Expression nesting is deeper than " +
+                                         std::to_string(MAX_NESTING_DEPTH));
+            }
+        }
+        ~DepthGuard() { --depth; }
+    } guard(depth);
+    
     if (peek().type == TokenType::NUMBER) {
-        return std::make_unique<LiteralExpression>(
+        return makeNode<LiteralExpression>(
             advance().value, LiteralExpression::Type::NUMBER
         );
     }
     if (peek().type == TokenType::STRING) {
-        return std::make_unique<LiteralExpression>(
+        return makeNode<LiteralExpression>(
             advance().value, LiteralExpression::Type::STRING
         );
     }
     if (peek().type == TokenType::IDENTIFIER) {
-        return std::make_unique<ColumnExpression>(advance().value);
+        if (peekNext().type == TokenType::LEFT_PAREN) {
+            return parseAggregate();
+        }
+        return parseColumnReference();
     }
     if (match(TokenType::LEFT_PAREN)) {
         auto expr = parseExpression();
@@ -120,8 +208,44 @@ std::unique_ptr<Expression> Parser::parsePrimary() {
     throw std::runtime_error("Expected expression");
 }
 
+std::unique_ptr<ColumnExpression> Parser::parseColumnReference() {
+    std::string name = advance().value;
+    if (!match(TokenType::DOT)) {
+        return makeNode<ColumnExpression>(std::move(name));
+    }
+    if (peek().type != TokenType::IDENTIFIER) {
+        throw std::runtime_error("Expected column name after '.'");
+    }
+    return makeNode<ColumnExpression>(std::move(name), advance().value);
+}
+
+std::unique_ptr<Expression> Parser::parseAggregate() {
+    std::string name = advance().value;
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    
+    AggregateExpression::Function function;
+    if (name == "COUNT") function = AggregateExpression::Function::COUNT;
+    else if (name == "SUM") function = AggregateExpression::Function::SUM;
+    else if (name == "MIN") function = AggregateExpression::Function::MIN;
+    else if (name == "MAX") function = AggregateExpression::Function::MAX;
+    else if (name == "AVG") function = AggregateExpression::Function::AVG;
+    else throw std::runtime_error("Unknown function " + name);
+    
+    advance();  // (
+    std::unique_ptr<Expression> argument;
+    if (function == AggregateExpression::Function::COUNT && match(TokenType::STAR)) {
+        // COUNT(*) has no argument
+    } else {
+        argument = parseExpression();
+    }
+    if (!match(TokenType::RIGHT_PAREN)) {
+        throw std::runtime_error("Expected closing parenthesis");
+    }
+    return makeNode<AggregateExpression>(function, std::move(argument));
+}
+
 std::unique_ptr<InsertStatement> Parser::parseInsert() {
-    auto stmt = std::make_unique<InsertStatement>();
+    auto stmt = makeNode<InsertStatement>();
     
     if (!match(TokenType::INTO)) {
         throw std::runtime_error("Expected INTO after INSERT");
@@ -162,12 +286,38 @@ std::unique_ptr<InsertStatement> Parser::parseInsert() {
     return stmt;
 }
 
+std::unique_ptr<CopyStatement> Parser::parseCopy() {
+    auto stmt = makeNode<CopyStatement>();
+    
+    if (peek().type != TokenType::IDENTIFIER) {
+        throw std::runtime_error("Expected table name");
+    }
+    stmt->table_name = advance().value;
+    
+    if (!match(TokenType::FROM)) {
+        throw std::runtime_error("Expected FROM after COPY table");
+    }
+    if (peek().type != TokenType::STRING) {
+        throw std::runtime_error("Expected quoted file path after FROM");
+    }
+    stmt->file_path = advance().value;
+    
+    return stmt;
+}
+
 
 
 Token Parser::peek() const {
     return tokens[current];
 }
 
+Token Parser::peekNext() const {
+    if (current + 1 < tokens.size()) {
+        return tokens[current + 1];
+    }
+    return tokens.back();
+}
+
 Token Parser::advance() {
     if (current < tokens.size()) {
         return tokens[current++];
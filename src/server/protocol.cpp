@@ -0,0 +1,46 @@
+#include "server/protocol.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void appendLength(std::string& out, uint32_t length) {
+    out += static_cast<char>((length >> 24) & 0xFF);
+    out += static_cast<char>((length >> 16) & 0xFF);
+    out += static_cast<char>((length >> 8) & 0xFF);
+    out += static_cast<char>(length & 0xFF);
+}
+
+} // namespace
+
+void appendFrame(std::string& out, const std::string& payload) {
+    appendLength(out, static_cast<uint32_t>(payload.size()));
+    out += payload;
+}
+
+void appendResponseFrame(std::string& out, ResponseStatus status, const std::string& body) {
+    appendLength(out, static_cast<uint32_t>(body.size() + 1));
+    out += static_cast<char>(status);
+    out += body;
+}
+
+bool readFrame(const std::string& buffer, size_t& offset, std::string& payload) {
+    if (buffer.size() - offset < FRAME_HEADER_SIZE) {
+        return false;
+    }
+    size_t length = 0;
+    for (size_t i = 0; i < FRAME_HEADER_SIZE; ++i) {
+        length = (length << 8) | static_cast<unsigned char>(buffer[offset + i]);
+    }
+    if (length > MAX_FRAME_SIZE) {
+        throw std::runtime_error("Frame exceeds maximum size");
+    }
+    if (buffer.size() - offset - FRAME_HEADER_SIZE < length) {
+        return false;
+    }
+    payload.assign(buffer, offset + FRAME_HEADER_SIZE, length);
+    offset += FRAME_HEADER_SIZE + length;
+    return true;
+}
@@ -0,0 +1,465 @@
+#include "server/server.h"
+#include "common/stats.h"
+#include "parser/lexer.h"
+#include "parser/parser.h"
+#include "server/protocol.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// epoll user data for the non-connection descriptors; connection ids start
+// above these.
+constexpr uint64_t WAKEUP_ID = 0;
+constexpr uint64_t TCP_LISTEN_ID = 1;
+constexpr uint64_t UNIX_LISTEN_ID = 2;
+constexpr uint64_t FIRST_CONNECTION_ID = 16;
+
+constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+// Stop reading once this much is buffered; still fits one maximal frame.
+constexpr size_t READ_BUFFER_LIMIT = FRAME_HEADER_SIZE + MAX_FRAME_SIZE;
+constexpr int MAX_EVENTS = 256;
+// Pipelined statements handed to one worker task.
+constexpr size_t PIPELINE_BATCH = 32;
+
+const char* const STATS_COMMAND = "\\stats";
+
+[[noreturn]] void throwSystemError(const std::string& what) {
+    throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+std::string executeRequest(const std::string& sql) {
+    std::string frame;
+    if (sql == STATS_COMMAND) {
+#ifdef DB_ENABLE_STATS
+        appendResponseFrame(frame, ResponseStatus::OK, Stats::instance().toPrometheus());
+#else
+        appendResponseFrame(frame, ResponseStatus::ERROR, "\\stats needs a build with ENABLE_STATS=ON");
+#endif
+        return frame;
+    }
+    try {
+        Lexer lexer(sql);
+        Parser parser(lexer.tokenize());
+        auto ast = parser.parse();
+        appendResponseFrame(frame, ResponseStatus::OK, ast->toString());
+    } catch (const std::exception& e) {
+        appendResponseFrame(frame, ResponseStatus::ERROR, e.what());
+    }
+    return frame;
+}
+
+struct Server::Connection {
+    uint64_t id;
+    int fd;
+    std::string read_buffer;
+    std::string write_buffer;
+    size_t write_offset = 0;
+    uint64_t next_sequence = 0;
+    uint64_t next_to_send = 0;
+    // Responses finished out of order, waiting for earlier ones.
+    std::map<uint64_t, std::string> ready;
+    uint32_t registered_events = EPOLLIN;
+    bool want_write = false;
+    bool read_closed = false;
+};
+
+Server::Server(ServerConfig cfg)
+    : config(std::move(cfg)),
+      epoll_fd(-1),
+      tcp_listen_fd(-1),
+      unix_listen_fd(-1),
+      wakeup_fd(-1),
+      bound_port(0),
+      stopping(false),
+      next_connection_id(FIRST_CONNECTION_ID) {}
+
+Server::~Server() {
+    // Workers reference the completion queue; finish them first.
+    workers.reset();
+    for (auto& entry : connections) {
+        close(entry.second->fd);
+    }
+    if (tcp_listen_fd >= 0) close(tcp_listen_fd);
+    if (unix_listen_fd >= 0) {
+        close(unix_listen_fd);
+        unlink(config.unix_socket_path.c_str());
+    }
+    if (wakeup_fd >= 0) close(wakeup_fd);
+    if (epoll_fd >= 0) close(epoll_fd);
+}
+
+void Server::start() {
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        throwSystemError("epoll_create1");
+    }
+    wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeup_fd < 0) {
+        throwSystemError("eventfd");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKEUP_ID;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &event) < 0) {
+        throwSystemError("epoll_ctl");
+    }
+    
+    listenTcp();
+    if (!config.unix_socket_path.empty()) {
+        listenUnix();
+    }
+    
+    size_t num_workers = config.worker_threads;
+    if (num_workers == 0) {
+        num_workers = std::thread::hardware_concurrency();
+    }
+    workers = std::make_unique<WorkerPool>(num_workers);
+}
+
+void Server::listenTcp() {
+    tcp_listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (tcp_listen_fd < 0) {
+        throwSystemError("socket");
+    }
+    int enable = 1;
+    setsockopt(tcp_listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.host.c_str(), &addr.sin_addr) != 1) {
+        throw std::runtime_error("Invalid listen address: " + config.host);
+    }
+    if (bind(tcp_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        throwSystemError("bind");
+    }
+    if (listen(tcp_listen_fd, SOMAXCONN) < 0) {
+        throwSystemError("listen");
+    }
+    
+    socklen_t len = sizeof(addr);
+    getsockname(tcp_listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    bound_port = ntohs(addr.sin_port);
+    
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = TCP_LISTEN_ID;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, tcp_listen_fd, &event) < 0) {
+        throwSystemError("epoll_ctl");
+    }
+}
+
+void Server::listenUnix() {
+    sockaddr_un addr{};
+    if (config.unix_socket_path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Unix socket path too long");
+    }
+    unix_listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (unix_listen_fd < 0) {
+        throwSystemError("socket");
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, config.unix_socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(config.unix_socket_path.c_str());
+    if (bind(unix_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        throwSystemError("bind");
+    }
+    if (listen(unix_listen_fd, SOMAXCONN) < 0) {
+        throwSystemError("listen");
+    }
+    
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = UNIX_LISTEN_ID;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, unix_listen_fd, &event) < 0) {
+        throwSystemError("epoll_ctl");
+    }
+}
+
+uint16_t Server::port() const {
+    return bound_port;
+}
+
+void Server::stop() {
+    stopping.store(true);
+    if (wakeup_fd >= 0) {
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeup_fd, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+void Server::run() {
+    epoll_event events[MAX_EVENTS];
+    while (!stopping.load()) {
+        int count = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throwSystemError("epoll_wait");
+        }
+        for (int i = 0; i < count; ++i) {
+            uint64_t id = events[i].data.u64;
+            if (id == WAKEUP_ID) {
+                uint64_t value;
+                while (read(wakeup_fd, &value, sizeof(value)) > 0) {
+                }
+                drainCompletions();
+                continue;
+            }
+            if (id == TCP_LISTEN_ID) {
+                acceptConnections(tcp_listen_fd);
+                continue;
+            }
+            if (id == UNIX_LISTEN_ID) {
+                acceptConnections(unix_listen_fd);
+                continue;
+            }
+            
+            auto it = connections.find(id);
+            if (it == connections.end()) {
+                continue;
+            }
+            Connection& conn = *it->second;
+            if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0 &&
+                (events[i].events & EPOLLIN) == 0) {
+                closeConnection(id);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) != 0) {
+                flush(conn);
+                if (connections.count(id) == 0) continue;
+            }
+            if ((events[i].events & EPOLLIN) != 0) {
+                readFromConnection(conn);
+            }
+        }
+    }
+}
+
+void Server::acceptConnections(int listen_fd) {
+    while (true) {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // EAGAIN, or a transient error such as EMFILE
+        }
+        if (listen_fd == tcp_listen_fd) {
+            int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        }
+        
+        auto conn = std::make_unique<Connection>();
+        conn->id = next_connection_id++;
+        conn->fd = fd;
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = conn->id;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+        connections.emplace(conn->id, std::move(conn));
+    }
+}
+
+void Server::readFromConnection(Connection& conn) {
+    char chunk[READ_CHUNK_SIZE];
+    // Frames are dispatched as they arrive so that reading stops as soon as
+    // the connection hits a backpressure limit.
+    while (!overloaded(conn) && conn.read_buffer.size() < READ_BUFFER_LIMIT) {
+        ssize_t n = read(conn.fd, chunk, sizeof(chunk));
+        if (n > 0) {
+            conn.read_buffer.append(chunk, static_cast<size_t>(n));
+            if (!processFrames(conn)) {
+                return;
+            }
+            continue;
+        }
+        if (n == 0) {
+            conn.read_closed = true;
+            break;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        closeConnection(conn.id);
+        return;
+    }
+    
+    if (conn.read_closed && conn.next_to_send == conn.next_sequence) {
+        closeConnection(conn.id);
+        return;
+    }
+    // Stops polling a half-closed socket, or an overloaded connection.
+    updateInterest(conn);
+}
+
+bool Server::processFrames(Connection& conn) {
+    std::vector<std::string> queries;
+    size_t offset = 0;
+    std::string payload;
+    const uint64_t inflight = conn.next_sequence - conn.next_to_send;
+    try {
+        while (inflight + queries.size() < config.max_inflight_requests &&
+               readFrame(conn.read_buffer, offset, payload)) {
+            queries.push_back(std::move(payload));
+        }
+    } catch (const std::runtime_error&) {
+        closeConnection(conn.id);
+        return false;
+    }
+    conn.read_buffer.erase(0, offset);
+    
+    if (!queries.empty()) {
+        dispatch(conn, std::move(queries));
+    }
+    return true;
+}
+
+bool Server::overloaded(const Connection& conn) const {
+    return conn.next_sequence - conn.next_to_send >= config.max_inflight_requests ||
+           conn.write_buffer.size() - conn.write_offset >= config.max_write_buffer_bytes;
+}
+
+void Server::dispatch(Connection& conn, std::vector<std::string> queries) {
+    for (size_t start = 0; start < queries.size(); start += PIPELINE_BATCH) {
+        size_t end = std::min(queries.size(), start + PIPELINE_BATCH);
+        std::vector<std::string> batch(std::make_move_iterator(queries.begin() + static_cast<std::ptrdiff_t>(start)),
+                                       std::make_move_iterator(queries.begin() + static_cast<std::ptrdiff_t>(end)));
+        uint64_t first_sequence = conn.next_sequence;
+        conn.next_sequence += batch.size();
+        uint64_t id = conn.id;
+        
+        workers->submit([this, id, first_sequence, batch = std::move(batch)] {
+            std::vector<Completion> done;
+            done.reserve(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                done.push_back({id, first_sequence + i, executeRequest(batch[i])});
+            }
+            {
+                std::lock_guard<std::mutex> lock(completion_mutex);
+                for (auto& completion : done) {
+                    completions.push_back(std::move(completion));
+                }
+            }
+            uint64_t one = 1;
+            ssize_t ignored = write(wakeup_fd, &one, sizeof(one));
+            (void)ignored;
+        });
+    }
+}
+
+void Server::drainCompletions() {
+    std::vector<Completion> batch;
+    {
+        std::lock_guard<std::mutex> lock(completion_mutex);
+        batch.swap(completions);
+    }
+    
+    std::vector<uint64_t> touched;
+    for (auto& completion : batch) {
+        auto it = connections.find(completion.connection_id);
+        if (it == connections.end()) {
+            continue;  // client went away
+        }
+        Connection& conn = *it->second;
+        conn.ready.emplace(completion.sequence, std::move(completion.frame));
+        touched.push_back(conn.id);
+    }
+    
+    for (uint64_t id : touched) {
+        auto it = connections.find(id);
+        if (it == connections.end()) {
+            continue;
+        }
+        Connection& conn = *it->second;
+        bool advanced = false;
+        auto ready_it = conn.ready.begin();
+        while (ready_it != conn.ready.end() && ready_it->first == conn.next_to_send) {
+            conn.write_buffer += ready_it->second;
+            ready_it = conn.ready.erase(ready_it);
+            conn.next_to_send++;
+            advanced = true;
+        }
+        if (advanced) {
+            flush(conn);
+        }
+    }
+}
+
+void Server::flush(Connection& conn) {
+    while (conn.write_offset < conn.write_buffer.size()) {
+        ssize_t n = send(conn.fd, conn.write_buffer.data() + conn.write_offset,
+                         conn.write_buffer.size() - conn.write_offset, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.write_offset += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            conn.want_write = true;
+            updateInterest(conn);
+            return;
+        }
+        closeConnection(conn.id);
+        return;
+    }
+    
+    conn.write_buffer.clear();
+    conn.write_offset = 0;
+    conn.want_write = false;
+    // Frames held back by the in-flight limit are not signalled by epoll.
+    if (!conn.read_buffer.empty() && !processFrames(conn)) {
+        return;
+    }
+    updateInterest(conn);
+    if (conn.read_closed && conn.next_to_send == conn.next_sequence) {
+        closeConnection(conn.id);
+    }
+}
+
+void Server::updateInterest(Connection& conn) {
+    uint32_t events = 0;
+    if (!conn.read_closed && !overloaded(conn)) events |= EPOLLIN;
+    if (conn.want_write) events |= EPOLLOUT;
+    if (events == conn.registered_events) {
+        return;
+    }
+    conn.registered_events = events;
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = conn.id;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn.fd, &event);
+}
+
+void Server::closeConnection(uint64_t id) {
+    auto it = connections.find(id);
+    if (it == connections.end()) {
+        return;
+    }
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, it->second->fd, nullptr);
+    close(it->second->fd);
+    connections.erase(it);
+}
@@ -0,0 +1,214 @@
+#include "storage/column_data.h"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+template <typename T>
+bool parseNumber(std::string_view text, T& value) {
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+bool parseBoolean(std::string_view text, int64_t& value) {
+    auto equals = [&](std::string_view word) {
+        return text.size() == word.size() &&
+               std::equal(text.begin(), text.end(), word.begin(),
+                          [](char a, char b) { return (a | 0x20) == b; });
+    };
+    if (equals("true") || equals("t") || text == "1") {
+        value = 1;
+        return true;
+    }
+    if (equals("false") || equals("f") || text == "0") {
+        value = 0;
+        return true;
+    }
+    return false;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date.
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto year_of_era = static_cast<unsigned>(year - era * 400);
+    const unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<int64_t>(day_of_era) - 719468;
+}
+
+bool parseDate(std::string_view text, int64_t& value) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') {
+        return false;
+    }
+    int year;
+    unsigned month, day;
+    if (!parseNumber(text.substr(0, 4), year) || !parseNumber(text.substr(5, 2), month) ||
+        !parseNumber(text.substr(8, 2), day)) {
+        return false;
+    }
+    static const unsigned DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month < 1 || month > 12 || day < 1) {
+        return false;
+    }
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (day > DAYS_IN_MONTH[month - 1] + (month == 2 && leap ? 1 : 0)) {
+        return false;
+    }
+    value = daysFromCivil(year, month, day);
+    return true;
+}
+
+} // namespace
+
+StorageKind storageKindFor(DataType type) {
+    switch (type) {
+        case DataType::INTEGER:
+        case DataType::BOOLEAN:
+        case DataType::DATE:
+            return StorageKind::INTEGER;
+        case DataType::FLOAT:
+            return StorageKind::FLOAT;
+        case DataType::VARCHAR:
+            return StorageKind::STRING;
+        case DataType::UNKNOWN:
+            break;
+    }
+    throw std::runtime_error("Cannot store values of type " + dataTypeToString(type));
+}
+
+// ColumnData
+ColumnData::ColumnData(DataType type) : data_type(type), storage_kind(storageKindFor(type)) {}
+
+DataType ColumnData::type() const {
+    return data_type;
+}
+
+StorageKind ColumnData::kind() const {
+    return storage_kind;
+}
+
+size_t ColumnData::size() const {
+    switch (storage_kind) {
+        case StorageKind::INTEGER: return integer_values.size();
+        case StorageKind::FLOAT: return float_values.size();
+        case StorageKind::STRING: return string_values.size();
+    }
+    return 0;
+}
+
+void ColumnData::reserve(size_t rows) {
+    switch (storage_kind) {
+        case StorageKind::INTEGER: integer_values.reserve(rows); break;
+        case StorageKind::FLOAT: float_values.reserve(rows); break;
+        case StorageKind::STRING: string_values.reserve(rows); break;
+    }
+}
+
+void ColumnData::appendInteger(int64_t value) {
+    integer_values.push_back(value);
+}
+
+void ColumnData::appendFloat(double value) {
+    float_values.push_back(value);
+}
+
+void ColumnData::appendString(std::string value) {
+    string_values.push_back(std::move(value));
+}
+
+bool ColumnData::appendParsed(std::string_view text) {
+    int64_t integer;
+    double number;
+    switch (data_type) {
+        case DataType::INTEGER:
+            if (!parseNumber(text, integer)) return false;
+            integer_values.push_back(integer);
+            return true;
+        case DataType::FLOAT:
+            if (!parseNumber(text, number)) return false;
+            float_values.push_back(number);
+            return true;
+        case DataType::BOOLEAN:
+            if (!parseBoolean(text, integer)) return false;
+            integer_values.push_back(integer);
+            return true;
+        case DataType::DATE:
+            if (!parseDate(text, integer)) return false;
+            integer_values.push_back(integer);
+            return true;
+        case DataType::VARCHAR:
+            string_values.emplace_back(text);
+            return true;
+        case DataType::UNKNOWN:
+            break;
+    }
+    return false;
+}
+
+void ColumnData::append(const ColumnData& other) {
+    if (other.data_type != data_type) {
+        throw std::runtime_error("Cannot append " + dataTypeToString(other.data_type) +
+                                 " column to " + dataTypeToString(data_type) + " column");
+    }
+    integer_values.insert(integer_values.end(), other.integer_values.begin(), other.integer_values.end());
+    float_values.insert(float_values.end(), other.float_values.begin(), other.float_values.end());
+    string_values.insert(string_values.end(), other.string_values.begin(), other.string_values.end());
+}
+
+void ColumnData::append(ColumnData&& other) {
+    if (other.data_type != data_type) {
+        throw std::runtime_error("Cannot append " + dataTypeToString(other.data_type) +
+                                 " column to " + dataTypeToString(data_type) + " column");
+    }
+    integer_values.insert(integer_values.end(), other.integer_values.begin(), other.integer_values.end());
+    float_values.insert(float_values.end(), other.float_values.begin(), other.float_values.end());
+    string_values.insert(string_values.end(), std::make_move_iterator(other.string_values.begin()),
+                         std::make_move_iterator(other.string_values.end()));
+}
+
+void ColumnData::appendFrom(const ColumnData& other, size_t row) {
+    switch (storage_kind) {
+        case StorageKind::INTEGER: integer_values.push_back(other.integer_values[row]); break;
+        case StorageKind::FLOAT: float_values.push_back(other.float_values[row]); break;
+        case StorageKind::STRING: string_values.push_back(other.string_values[row]); break;
+    }
+}
+
+// TableData
+TableData::TableData(const TableInfo& info) {
+    columns.reserve(info.columns.size());
+    for (const auto& col : info.columns) {
+        columns.emplace_back(col.type);
+    }
+}
+
+TableData::TableData(const std::vector<DataType>& types) {
+    columns.reserve(types.size());
+    for (DataType type : types) {
+        columns.emplace_back(type);
+    }
+}
+
+size_t TableData::rowCount() const {
+    return columns.empty() ? 0 : columns.front().size();
+}
+
+void TableData::append(const TableData& other) {
+    if (other.columns.size() != columns.size()) {
+        throw std::runtime_error("Cannot append rows with a different column count");
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+        columns[i].append(other.columns[i]);
+    }
+}
@@ -0,0 +1,84 @@
+#include "storage/insert_batch.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool literalFits(DataType type, LiteralExpression::Type literal) {
+    switch (type) {
+        case DataType::INTEGER:
+        case DataType::FLOAT:
+            return literal == LiteralExpression::Type::NUMBER;
+        case DataType::VARCHAR:
+        case DataType::DATE:
+            return literal == LiteralExpression::Type::STRING;
+        case DataType::BOOLEAN:
+            return true;
+        case DataType::UNKNOWN:
+            break;
+    }
+    return false;
+}
+
+// Column id of each VALUES entry.
+std::vector<size_t> targetColumns(const TableInfo& table, const InsertStatement& stmt) {
+    std::vector<size_t> targets;
+    if (stmt.columns.empty()) {
+        for (size_t i = 0; i < table.columns.size(); ++i) {
+            targets.push_back(i);
+        }
+        return targets;
+    }
+    
+    std::vector<bool> seen(table.columns.size(), false);
+    for (const std::string& name : stmt.columns) {
+        const ColumnInfo* column = table.getColumn(name);
+        if (column == nullptr) {
+            throw std::runtime_error("Column '" + name + "' does not exist in table '" + table.name + "'");
+        }
+        if (seen[column->column_id]) {
+            throw std::runtime_error("Column '" + name + "' is listed twice");
+        }
+        seen[column->column_id] = true;
+        targets.push_back(column->column_id);
+    }
+    if (targets.size() != table.columns.size()) {
+        throw std::runtime_error("INSERT must supply every column of table '" + table.name + "'");
+    }
+    return targets;
+}
+
+} // namespace
+
+TableData buildInsertBatch(const TableInfo& table, const std::vector<const InsertStatement*>& statements) {
+    TableData batch(table);
+    for (ColumnData& column : batch.columns) {
+        column.reserve(statements.size());
+    }
+    
+    for (const InsertStatement* stmt : statements) {
+        if (!equalsIgnoreCase(stmt->table_name, table.name)) {
+            throw std::runtime_error("INSERT into '" + stmt->table_name + "' in a batch for '" +
+                                     table.name + "'");
+        }
+        std::vector<size_t> targets = targetColumns(table, *stmt);
+        if (stmt->values.size() != targets.size()) {
+            throw std::runtime_error("INSERT has " + std::to_string(stmt->values.size()) +
+                                     " values for " + std::to_string(targets.size()) + " columns");
+        }
+        
+        // A failure leaves a ragged batch behind, but it is never returned.
+        for (size_t i = 0; i < targets.size(); ++i) {
+            const ColumnInfo& column = table.columns[targets[i]];
+            auto* literal = dynamic_cast<const LiteralExpression*>(stmt->values[i].get());
+            if (literal == nullptr || !literalFits(column.type, literal->type) ||
+                !batch.columns[targets[i]].appendParsed(literal->value)) {
+                throw std::runtime_error("Value " + stmt->values[i]->toString() + " does not fit " +
+                                         dataTypeToString(column.type) + " column '" + column.name + "'");
+            }
+        }
+    }
+    return batch;
+}
@@ -0,0 +1,323 @@
+#include "storage/wal.h"
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr size_t HEADER_BYTES = 2 * sizeof(uint32_t);
+constexpr size_t MIN_PAYLOAD_BYTES = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+// CRC-32 (IEEE 802.3, reflected).
+uint32_t crc32(const char* data, size_t size) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) != 0 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+            }
+            entries[i] = crc;
+        }
+        return entries;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+class PayloadReader {
+public:
+    explicit PayloadReader(std::string_view data) : data(data), pos(0) {}
+
+    template <typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    const char* take(size_t bytes) {
+        if (bytes > data.size() - pos) {
+            throw std::runtime_error("Corrupt WAL record");
+        }
+        const char* start = data.data() + pos;
+        pos += bytes;
+        return start;
+    }
+
+    bool done() const { return pos == data.size(); }
+
+private:
+    std::string_view data;
+    size_t pos;
+};
+
+std::string encodeRecord(size_t table_id, const TableData& rows) {
+    std::string record(HEADER_BYTES, '\0');
+    put<uint64_t>(record, table_id);
+    put<uint32_t>(record, static_cast<uint32_t>(rows.rowCount()));
+    put<uint32_t>(record, static_cast<uint32_t>(rows.columns.size()));
+    for (const ColumnData& column : rows.columns) {
+        put<uint8_t>(record, static_cast<uint8_t>(column.type()));
+        switch (column.kind()) {
+            case StorageKind::INTEGER:
+                record.append(reinterpret_cast<const char*>(column.integers().data()),
+                              column.size() * sizeof(int64_t));
+                break;
+            case StorageKind::FLOAT:
+                record.append(reinterpret_cast<const char*>(column.floats().data()),
+                              column.size() * sizeof(double));
+                break;
+            case StorageKind::STRING:
+                for (const std::string& value : column.strings()) {
+                    put<uint32_t>(record, static_cast<uint32_t>(value.size()));
+                    record += value;
+                }
+                break;
+        }
+    }
+
+    const size_t payload_bytes = record.size() - HEADER_BYTES;
+    if (payload_bytes > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("INSERT batch is too large for one WAL record");
+    }
+    const auto size = static_cast<uint32_t>(payload_bytes);
+    const uint32_t checksum = crc32(record.data() + HEADER_BYTES, payload_bytes);
+    std::memcpy(&record[0], &size, sizeof(size));
+    std::memcpy(&record[sizeof(size)], &checksum, sizeof(checksum));
+    return record;
+}
+
+TableData decodePayload(std::string_view payload, size_t& table_id) {
+    PayloadReader reader(payload);
+    table_id = static_cast<size_t>(reader.get<uint64_t>());
+    const uint32_t num_rows = reader.get<uint32_t>();
+    const uint32_t num_columns = reader.get<uint32_t>();
+
+    TableData rows;
+    for (uint32_t c = 0; c < num_columns; ++c) {
+        const uint8_t type = reader.get<uint8_t>();
+        if (type >= static_cast<uint8_t>(DataType::UNKNOWN)) {
+            throw std::runtime_error("Corrupt WAL record");
+        }
+        ColumnData column(static_cast<DataType>(type));
+        column.reserve(num_rows);
+        for (uint32_t r = 0; r < num_rows; ++r) {
+            switch (column.kind()) {
+                case StorageKind::INTEGER: column.appendInteger(reader.get<int64_t>()); break;
+                case StorageKind::FLOAT: column.appendFloat(reader.get<double>()); break;
+                case StorageKind::STRING: {
+                    const uint32_t length = reader.get<uint32_t>();
+                    column.appendString(std::string(reader.take(length), length));
+                    break;
+                }
+            }
+        }
+        rows.columns.push_back(std::move(column));
+    }
+    if (!reader.done()) {
+        throw std::runtime_error("Corrupt WAL record");
+    }
+    return rows;
+}
+
+struct FileCloser {
+    void operator()(FILE* file) const { std::fclose(file); }
+};
+
+// Visits the payload of every intact record and returns the number of bytes
+// they occupy; whatever follows is a torn or corrupt tail. A missing file is
+// an empty log.
+size_t scanLog(const std::string& path, const std::function<void(std::string_view)>& visit,
+               uint64_t& records) {
+    records = 0;
+    std::unique_ptr<FILE, FileCloser> file(std::fopen(path.c_str(), "rb"));
+    if (!file) {
+        if (errno == ENOENT) return 0;
+        throw std::runtime_error("Cannot open WAL '" + path + "': " + std::strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fileno(file.get()), &st) != 0) {
+        throw std::runtime_error("Cannot stat WAL '" + path + "': " + std::strerror(errno));
+    }
+    const auto file_bytes = static_cast<size_t>(st.st_size);
+
+    size_t valid_bytes = 0;
+    std::string payload;
+    while (true) {
+        uint32_t header[2];
+        if (std::fread(header, sizeof(header), 1, file.get()) != 1) break;
+        const size_t payload_bytes = header[0];
+        if (payload_bytes < MIN_PAYLOAD_BYTES ||
+            payload_bytes > file_bytes - valid_bytes - HEADER_BYTES) break;
+        payload.resize(payload_bytes);
+        if (std::fread(payload.data(), 1, payload_bytes, file.get()) != payload_bytes) break;
+        if (crc32(payload.data(), payload_bytes) != header[1]) break;
+
+        if (visit) visit(payload);
+        valid_bytes += HEADER_BYTES + payload_bytes;
+        records++;
+    }
+    return valid_bytes;
+}
+
+void syncParentDirectory(const std::string& path) {
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    int dir = open(parent.empty() ? "." : parent.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dir >= 0) {
+        fsync(dir);
+        close(dir);
+    }
+}
+
+// Empty on success, otherwise a description of the failure.
+std::string writeAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return std::string("WAL write failed: ") + std::strerror(errno);
+        }
+        written += static_cast<size_t>(n);
+    }
+    return "";
+}
+
+} // namespace
+
+WriteAheadLog::WriteAheadLog(const std::string& path, WalOptions options)
+    : fd(-1), options(std::move(options)), pending_records(0), next_lsn(1), durable_lsn(0),
+      commits(0), stopping(false) {
+    uint64_t records = 0;
+    const size_t valid_bytes = scanLog(path, nullptr, records);
+
+    struct stat st;
+    const bool created = stat(path.c_str(), &st) != 0;
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open WAL '" + path + "': " + std::strerror(errno));
+    }
+    if (!created && static_cast<size_t>(st.st_size) > valid_bytes) {
+        if (ftruncate(fd, static_cast<off_t>(valid_bytes)) != 0 || fdatasync(fd) != 0) {
+            std::string reason = std::strerror(errno);
+            close(fd);
+            throw std::runtime_error("Cannot truncate WAL '" + path + "': " + reason);
+        }
+    }
+    if (created && this->options.sync) {
+        syncParentDirectory(path);
+    }
+
+    next_lsn = records + 1;
+    durable_lsn = records;
+    writer = std::thread(&WriteAheadLog::writerLoop, this);
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_one();
+    writer.join();
+    close(fd);
+}
+
+uint64_t WriteAheadLog::append(size_t table_id, const TableData& rows) {
+    std::string record = encodeRecord(table_id, rows);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+    const uint64_t lsn = next_lsn++;
+    pending += record;
+    pending_records++;
+    if (pending_records == 1 || pending_records >= options.max_batch_records) {
+        work_ready.notify_one();
+    }
+    committed.wait(lock, [&] { return durable_lsn >= lsn || !error.empty(); });
+    if (durable_lsn < lsn) {
+        throw std::runtime_error(error);
+    }
+    return lsn;
+}
+
+uint64_t WriteAheadLog::durableLsn() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return durable_lsn;
+}
+
+uint64_t WriteAheadLog::commitCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return commits;
+}
+
+void WriteAheadLog::writerLoop() {
+    std::string batch;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        work_ready.wait(lock, [&] { return stopping || pending_records > 0; });
+        if (pending_records == 0) {
+            break;
+        }
+        if (options.max_commit_delay.count() > 0 && !stopping &&
+            pending_records < options.max_batch_records) {
+            work_ready.wait_for(lock, options.max_commit_delay, [&] {
+                return stopping || pending_records >= options.max_batch_records;
+            });
+        }
+
+        batch.swap(pending);
+        pending_records = 0;
+        const uint64_t batch_end = next_lsn - 1;
+        lock.unlock();
+
+        std::string failure = writeAll(fd, batch);
+        if (failure.empty() && options.sync && fdatasync(fd) != 0) {
+            failure = std::string("WAL sync failed: ") + std::strerror(errno);
+        }
+        batch.clear();
+
+        lock.lock();
+        if (!failure.empty()) {
+            error = failure;
+            committed.notify_all();
+            break;
+        }
+        durable_lsn = batch_end;
+        commits++;
+        committed.notify_all();
+    }
+}
+
+size_t WriteAheadLog::replay(const std::string& path,
+                             const std::function<void(size_t, TableData&&)>& apply) {
+    uint64_t records = 0;
+    scanLog(path, [&](std::string_view payload) {
+        size_t table_id;
+        TableData rows = decodePayload(payload, table_id);
+        apply(table_id, std::move(rows));
+    }, records);
+    return static_cast<size_t>(records);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "binder/binder.h"
+#include "execution/hash_aggregate.h"
+#include "parser/lexer.h"
+#include "parser/parser.h"
+#include <map>
+#include <random>
+#include <tuple>
+
+class HashAggregateTest : public ::testing::Test {
+protected:
+    Catalog catalog;
+    TableInfo* sales = nullptr;
+
+    void SetUp() override {
+        sales = catalog.createTable("sales");
+        sales->addColumn(ColumnInfo("region", DataType::VARCHAR, 0));
+        sales->addColumn(ColumnInfo("store", DataType::INTEGER, 1));
+        sales->addColumn(ColumnInfo("amount", DataType::FLOAT, 2));
+        sales->addColumn(ColumnInfo("units", DataType::INTEGER, 3));
+    }
+
+    TableData makeSales(size_t rows, size_t stores) {
+        TableData data(*sales);
+        std::mt19937_64 rng(7);
+        const char* regions[] = {"north", "south", "east", "west"};
+        for (size_t i = 0; i < rows; ++i) {
+            data.columns[0].appendString(regions[rng() % 4]);
+            data.columns[1].appendInteger(static_cast<int64_t>(rng() % stores));
+            data.columns[2].appendFloat(static_cast<double>(rng() % 10000) / 100.0);
+            data.columns[3].appendInteger(static_cast<int64_t>(rng() % 50) - 10);
+        }
+        return data;
+    }
+
+    TableData aggregate(const std::string& sql, const TableData& data, AggregateOptions options) {
+        Lexer lexer(sql);
+        Parser parser(lexer.tokenize());
+        auto stmt = parser.parse();
+        Binder binder(catalog);
+        AggregatePlan plan = binder.bindAggregate(dynamic_cast<SelectStatement&>(*stmt));
+        return HashAggregator(plan, options).execute(data);
+    }
+};
+
+TEST_F(HashAggregateTest, GroupByMatchesReference) {
+    TableData data = makeSales(20000, 500);
+    
+    struct Expected { int64_t count = 0; int64_t units = 0; double amount = 0; int64_t min_units = INT64_MAX; };
+    std::map<std::pair<std::string, int64_t>, Expected> expected;
+    for (size_t i = 0; i < data.rowCount(); ++i) {
+        auto& e = expected[{data.columns[0].stringAt(i), data.columns[1].integerAt(i)}];
+        e.count++;
+        e.units += data.columns[3].integerAt(i);
+        e.amount += data.columns[2].floatAt(i);
+        e.min_units = std::min(e.min_units, data.columns[3].integerAt(i));
+    }
+    
+    for (size_t threads : {1, 3, 8}) {
+        AggregateOptions options;
+        options.num_threads = threads;
+        options.local_table_bytes = 4096;  // force spills to partitions
+        TableData result = aggregate(
+            "SELECT region, store, COUNT(*), SUM(units), SUM(amount), MIN(units) "
+            "FROM sales GROUP BY region, store", data, options);
+        
+        ASSERT_EQ(result.rowCount(), expected.size());
+        for (size_t i = 0; i < result.rowCount(); ++i) {
+            auto it = expected.find({result.columns[0].stringAt(i), result.columns[1].integerAt(i)});
+            ASSERT_NE(it, expected.end());
+            EXPECT_EQ(result.columns[2].integerAt(i), it->second.count);
+            EXPECT_EQ(result.columns[3].integerAt(i), it->second.units);
+            EXPECT_NEAR(result.columns[4].floatAt(i), it->second.amount, 1e-6);
+            EXPECT_EQ(result.columns[5].integerAt(i), it->second.min_units);
+        }
+    }
+}
+
+TEST_F(HashAggregateTest, GlobalAggregates) {
+    TableData data = makeSales(1000, 10);
+    
+    AggregateOptions options;
+    options.num_threads = 4;
+    TableData result = aggregate(
+        "SELECT COUNT(*), AVG(units), MIN(region), MAX(region), MAX(amount) FROM sales", data, options);
+    
+    double total_units = 0;
+    double max_amount = 0;
+    for (size_t i = 0; i < data.rowCount(); ++i) {
+        total_units += static_cast<double>(data.columns[3].integerAt(i));
+        max_amount = std::max(max_amount, data.columns[2].floatAt(i));
+    }
+    ASSERT_EQ(result.rowCount(), 1);
+    EXPECT_EQ(result.columns[0].integerAt(0), 1000);
+    EXPECT_NEAR(result.columns[1].floatAt(0), total_units / 1000.0, 1e-9);
+    EXPECT_EQ(result.columns[2].stringAt(0), "east");
+    EXPECT_EQ(result.columns[3].stringAt(0), "west");
+    EXPECT_EQ(result.columns[4].floatAt(0), max_amount);
+}
+
+TEST_F(HashAggregateTest, EmptyInput) {
+    TableData data(*sales);
+    AggregateOptions options;
+    options.num_threads = 2;
+    
+    TableData grouped = aggregate("SELECT region, COUNT(*) FROM sales GROUP BY region", data, options);
+    EXPECT_EQ(grouped.rowCount(), 0);
+    
+    TableData global = aggregate("SELECT COUNT(*), SUM(units) FROM sales", data, options);
+    ASSERT_EQ(global.rowCount(), 1);
+    EXPECT_EQ(global.columns[0].integerAt(0), 0);
+    EXPECT_EQ(global.columns[1].integerAt(0), 0);
+}
+
+TEST_F(HashAggregateTest, IntegerSumOverflowIsAnError) {
+    auto makeUnits = [&](std::initializer_list<int64_t> units) {
+        TableData data(*sales);
+        for (int64_t value : units) {
+            data.columns[0].appendString("north");
+            data.columns[1].appendInteger(1);
+            data.columns[2].appendFloat(1.0);
+            data.columns[3].appendInteger(value);
+        }
+        return data;
+    };
+    const std::string sql = "SELECT region, SUM(units) FROM sales GROUP BY region";
+    
+    for (size_t threads : {1, 2}) {
+        AggregateOptions options;
+        options.num_threads = threads;
+        TableData fits = aggregate(sql, makeUnits({INT64_MAX - 1, INT64_MIN, 1, -1}), options);
+        ASSERT_EQ(fits.rowCount(), 1);
+        EXPECT_EQ(fits.columns[1].integerAt(0), -2);
+        
+        // With two threads each partial sum fits and the merge overflows.
+        EXPECT_THROW(aggregate(sql, makeUnits({INT64_MAX, 1}), options), std::runtime_error);
+        EXPECT_THROW(aggregate(sql, makeUnits({INT64_MIN, -1}), options), std::runtime_error);
+    }
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include "binder/binder.h"
+#include "parser/lexer.h"
+#include "parser/parser.h"
+
+class BinderTest : public ::testing::Test {
+protected:
+    Catalog catalog;
+
+    void SetUp() override {
+        auto* emp = catalog.createTable("emp");
+        emp->addColumn(ColumnInfo("id", DataType::INTEGER, 0, false));
+        emp->addColumn(ColumnInfo("name", DataType::VARCHAR, 1, false, 50));
+        emp->addColumn(ColumnInfo("dept", DataType::VARCHAR, 2));
+        emp->addColumn(ColumnInfo("salary", DataType::FLOAT, 3));
+        emp->addColumn(ColumnInfo("age", DataType::INTEGER, 4));
+        
+        auto* dept = catalog.createTable("dept");
+        dept->addColumn(ColumnInfo("id", DataType::INTEGER, 0, false));
+        dept->addColumn(ColumnInfo("title", DataType::VARCHAR, 1));
+        dept->addColumn(ColumnInfo("budget", DataType::FLOAT, 2));
+    }
+
+    std::unique_ptr<SelectStatement> parseSelect(const std::string& sql) {
+        Lexer lexer(sql);
+        Parser parser(lexer.tokenize());
+        auto stmt = parser.parse();
+        return std::unique_ptr<SelectStatement>(dynamic_cast<SelectStatement*>(stmt.release()));
+    }
+
+    JoinPlan bindJoin(const std::string& sql) {
+        Binder binder(catalog);
+        return binder.bindJoin(*parseSelect(sql));
+    }
+
+    AggregatePlan bindAggregate(const std::string& sql) {
+        Binder binder(catalog);
+        return binder.bindAggregate(*parseSelect(sql));
+    }
+
+    SortPlan bindSort(const std::string& sql) {
+        Binder binder(catalog);
+        return binder.bindSort(*parseSelect(sql));
+    }
+};
+
+TEST_F(BinderTest, CatalogLookupsAreCaseInsensitive) {
+    EXPECT_NE(catalog.getTable("EMP"), nullptr);
+    EXPECT_NE(catalog.getTable("emp")->getColumn("Salary"), nullptr);
+    EXPECT_EQ(catalog.getTable("missing"), nullptr);
+    EXPECT_THROW(catalog.createTable("Emp"), std::runtime_error);
+}
+
+TEST_F(BinderTest, AggregateResultTypes) {
+    using Function = AggregateExpression::Function;
+    EXPECT_EQ(aggregateResultType(Function::COUNT, DataType::VARCHAR), DataType::INTEGER);
+    EXPECT_EQ(aggregateResultType(Function::SUM, DataType::INTEGER), DataType::INTEGER);
+    EXPECT_EQ(aggregateResultType(Function::SUM, DataType::FLOAT), DataType::FLOAT);
+    EXPECT_EQ(aggregateResultType(Function::AVG, DataType::INTEGER), DataType::FLOAT);
+    EXPECT_EQ(aggregateResultType(Function::MIN, DataType::VARCHAR), DataType::VARCHAR);
+    EXPECT_THROW(aggregateResultType(Function::SUM, DataType::VARCHAR), std::runtime_error);
+    EXPECT_THROW(aggregateResultType(Function::AVG, DataType::BOOLEAN), std::runtime_error);
+}
+
+TEST_F(BinderTest, BindGroupByAggregate) {
+    auto plan = bindAggregate("SELECT dept, COUNT(*), SUM(age), AVG(salary), MAX(name) FROM emp GROUP BY dept");
+    
+    ASSERT_EQ(plan.group_columns.size(), 1);
+    EXPECT_EQ(plan.group_columns[0], 2);
+    ASSERT_EQ(plan.aggregates.size(), 4);
+    EXPECT_FALSE(plan.aggregates[0].has_argument);
+    EXPECT_EQ(plan.aggregates[1].column_id, 4);
+    
+    ASSERT_EQ(plan.outputs.size(), 5);
+    EXPECT_FALSE(plan.outputs[0].is_aggregate);
+    EXPECT_EQ(plan.outputs[0].type, DataType::VARCHAR);
+    EXPECT_EQ(plan.outputs[1].type, DataType::INTEGER);
+    EXPECT_EQ(plan.outputs[2].type, DataType::INTEGER);
+    EXPECT_EQ(plan.outputs[3].type, DataType::FLOAT);
+    EXPECT_EQ(plan.outputs[4].type, DataType::VARCHAR);
+    EXPECT_EQ(plan.outputs[3].name, "AVG(Column(salary))");
+}
+
+TEST_F(BinderTest, AggregateBindingErrors) {
+    EXPECT_THROW(bindAggregate("SELECT SUM(name) FROM emp"), std::runtime_error);
+    EXPECT_THROW(bindAggregate("SELECT name, COUNT(*) FROM emp GROUP BY dept"), std::runtime_error);
+    EXPECT_THROW(bindAggregate("SELECT COUNT(missing) FROM emp"), std::runtime_error);
+    EXPECT_THROW(bindAggregate("SELECT COUNT(*) FROM missing"), std::runtime_error);
+    EXPECT_THROW(bindAggregate("SELECT *, COUNT(*) FROM emp"), std::runtime_error);
+    EXPECT_THROW(bindAggregate("SELECT SUM(COUNT(id)) FROM emp"), std::runtime_error);
+    EXPECT_THROW(bindAggregate("SELECT dept, COUNT(*) FROM emp GROUP BY dept ORDER BY dept DESC LIMIT 1"),
+                 std::runtime_error);
+    EXPECT_THROW(bindAggregate("SELECT COUNT(*) FROM emp LIMIT 1"), std::runtime_error);
+}
+
+TEST_F(BinderTest, BindJoin) {
+    auto plan = bindJoin("SELECT name FROM emp JOIN dept ON dept.title = emp.dept");
+    
+    EXPECT_EQ(plan.left_table->name, "emp");
+    EXPECT_EQ(plan.right_table->name, "dept");
+    EXPECT_EQ(plan.left_key, 2);
+    EXPECT_EQ(plan.right_key, 1);
+    EXPECT_EQ(plan.key_type, DataType::VARCHAR);
+    
+    auto unqualified = bindJoin("SELECT name FROM emp JOIN dept ON title = name");
+    EXPECT_EQ(unqualified.left_key, 1);
+    EXPECT_EQ(unqualified.right_key, 1);
+}
+
+TEST_F(BinderTest, JoinSelectColumns) {
+    auto plan = bindJoin("SELECT title, emp.id, salary FROM emp JOIN dept ON emp.id = dept.id");
+    ASSERT_EQ(plan.outputs.size(), 3);
+    EXPECT_TRUE(plan.outputs[0].from_right);
+    EXPECT_EQ(plan.outputs[0].column_id, 1);
+    EXPECT_EQ(plan.outputs[0].type, DataType::VARCHAR);
+    EXPECT_FALSE(plan.outputs[1].from_right);
+    EXPECT_EQ(plan.outputs[1].column_id, 0);
+    EXPECT_FALSE(plan.outputs[2].from_right);
+    EXPECT_EQ(plan.outputs[2].name, "salary");
+    
+    auto star = bindJoin("SELECT * FROM emp JOIN dept ON emp.id = dept.id");
+    ASSERT_EQ(star.outputs.size(), 8);
+    EXPECT_FALSE(star.outputs[4].from_right);
+    EXPECT_EQ(star.outputs[4].name, "age");
+    EXPECT_TRUE(star.outputs[5].from_right);
+    EXPECT_EQ(star.outputs[5].name, "id");
+}
+
+TEST_F(BinderTest, JoinBindingErrors) {
+    EXPECT_THROW(bindJoin("SELECT name FROM emp"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT name FROM emp JOIN missing ON emp.id = missing.id"), std::runtime_error);
+    // `id` exists in both tables.
+    EXPECT_THROW(bindJoin("SELECT name FROM emp JOIN dept ON id = title"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT name FROM emp JOIN dept ON emp.id = emp.age"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT name FROM emp JOIN dept ON emp.id > dept.id"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT name FROM emp JOIN dept ON emp.id = dept.title"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT name FROM emp JOIN dept ON age = budget"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT name FROM emp JOIN dept ON emp.id = dept.missing"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT nosuch FROM emp JOIN dept ON emp.id = dept.id"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT id FROM emp JOIN dept ON emp.id = dept.id"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT name FROM emp JOIN dept ON emp.id = dept.id WHERE age > 1"),
+                 std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT nosuch FROM emp JOIN dept ON emp.id = dept.id WHERE garbage > 1"),
+                 std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT COUNT(*) FROM emp JOIN dept ON emp.id = dept.id"), std::runtime_error);
+    EXPECT_THROW(bindJoin("SELECT name FROM emp JOIN dept ON emp.id = dept.id ORDER BY name"),
+                 std::runtime_error);
+}
+
+TEST_F(BinderTest, QualifiedColumnsInAggregates) {
+    auto plan = bindAggregate("SELECT emp.dept, COUNT(emp.id) FROM emp GROUP BY emp.dept");
+    EXPECT_EQ(plan.group_columns[0], 2);
+    EXPECT_THROW(bindAggregate("SELECT COUNT(dept.id) FROM emp"), std::runtime_error);
+}
+
+TEST_F(BinderTest, BindOrderBy) {
+    auto plan = bindSort("SELECT name FROM emp ORDER BY Dept, emp.salary DESC LIMIT 5");
+    EXPECT_EQ(plan.table, catalog.getTable("emp"));
+    ASSERT_EQ(plan.keys.size(), 2);
+    EXPECT_EQ(plan.keys[0].column_id, 2);
+    EXPECT_FALSE(plan.keys[0].descending);
+    EXPECT_EQ(plan.keys[1].column_id, 3);
+    EXPECT_EQ(plan.keys[1].type, DataType::FLOAT);
+    EXPECT_TRUE(plan.keys[1].descending);
+    EXPECT_EQ(plan.limit, 5);
+    ASSERT_EQ(plan.outputs.size(), 1);
+    EXPECT_EQ(plan.outputs[0].column_id, 1);
+    EXPECT_EQ(plan.outputs[0].type, DataType::VARCHAR);
+    
+    auto star = bindSort("SELECT * FROM emp ORDER BY id");
+    ASSERT_EQ(star.outputs.size(), 5);
+    EXPECT_EQ(star.outputs[3].name, "salary");
+    
+    EXPECT_FALSE(bindSort("SELECT name FROM emp ORDER BY id").limit.has_value());
+}
+
+TEST_F(BinderTest, OrderByBindingErrors) {
+    EXPECT_THROW(bindSort("SELECT name FROM emp ORDER BY missing"), std::runtime_error);
+    EXPECT_THROW(bindSort("SELECT name FROM emp ORDER BY dept.id"), std::runtime_error);
+    EXPECT_THROW(bindSort("SELECT name FROM missing ORDER BY id"), std::runtime_error);
+    EXPECT_THROW(bindSort("SELECT nosuchcol FROM emp ORDER BY id LIMIT 5"), std::runtime_error);
+    EXPECT_THROW(bindSort("SELECT dept.title FROM emp ORDER BY id"), std::runtime_error);
+    EXPECT_THROW(bindSort("SELECT COUNT(id) FROM emp ORDER BY id"), std::runtime_error);
+    EXPECT_THROW(bindSort("SELECT name FROM emp JOIN dept ON emp.id = dept.id ORDER BY name"),
+                 std::runtime_error);
+}
+
+TEST_F(BinderTest, BindCopy) {
+    Lexer lexer("COPY Emp FROM 'emp.csv'");
+    Parser parser(lexer.tokenize());
+    auto stmt = parser.parse();
+    Binder binder(catalog);
+    
+    CopyPlan plan = binder.bindCopy(dynamic_cast<const CopyStatement&>(*stmt));
+    EXPECT_EQ(plan.table, catalog.getTable("emp"));
+    EXPECT_EQ(plan.file_path, "emp.csv");
+    
+    CopyStatement missing;
+    missing.table_name = "missing";
+    missing.file_path = "x.csv";
+    EXPECT_THROW(binder.bindCopy(missing), std::runtime_error);
+}
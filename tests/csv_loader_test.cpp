@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "execution/csv_loader.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+class CsvLoaderTest : public ::testing::Test {
+protected:
+    TableInfo table{"people", 0};
+
+    void SetUp() override {
+        table.addColumn(ColumnInfo("id", DataType::INTEGER, 0));
+        table.addColumn(ColumnInfo("name", DataType::VARCHAR, 1));
+        table.addColumn(ColumnInfo("score", DataType::FLOAT, 2));
+        table.addColumn(ColumnInfo("active", DataType::BOOLEAN, 3));
+        table.addColumn(ColumnInfo("born", DataType::DATE, 4));
+    }
+
+    TableData load(const std::string& text, CsvOptions options = {}) {
+        TableData data(table);
+        CsvLoader(table, options).load(text, data);
+        return data;
+    }
+
+    std::string loadError(const std::string& text) {
+        TableData data(table);
+        try {
+            CsvLoader(table).load(text, data);
+        } catch (const std::runtime_error& e) {
+            EXPECT_EQ(data.rowCount(), 0);
+            return e.what();
+        }
+        ADD_FAILURE() << "no error for: " << text;
+        return "";
+    }
+
+    static void expectSameRows(const TableData& a, const TableData& b) {
+        ASSERT_EQ(a.rowCount(), b.rowCount());
+        for (size_t c = 0; c < a.columns.size(); ++c) {
+            EXPECT_EQ(a.columns[c].integers(), b.columns[c].integers());
+            EXPECT_EQ(a.columns[c].floats(), b.columns[c].floats());
+            EXPECT_EQ(a.columns[c].strings(), b.columns[c].strings());
+        }
+    }
+};
+
+TEST_F(CsvLoaderTest, ConvertsFieldsToColumnTypes) {
+    CsvOptions options;
+    options.header = true;
+    TableData data = load("id,name,score,active,born\r\n"
+                          "1,Alice,2.5,true,1970-01-02\r\n"
+                          "-7,\"Smith, \"\"Bob\"\"\",-1e3,F,2000-03-01\n"
+                          "\n"
+                          "42,\"multi\nline\",0,1,1969-12-31",
+                          options);
+    
+    ASSERT_EQ(data.rowCount(), 3);
+    EXPECT_EQ(data.columns[0].integers(), (std::vector<int64_t>{1, -7, 42}));
+    EXPECT_EQ(data.columns[1].strings(), (std::vector<std::string>{"Alice", "Smith, \"Bob\"", "multi\nline"}));
+    EXPECT_EQ(data.columns[2].floats(), (std::vector<double>{2.5, -1000.0, 0.0}));
+    EXPECT_EQ(data.columns[3].integers(), (std::vector<int64_t>{1, 0, 1}));
+    EXPECT_EQ(data.columns[4].integers(), (std::vector<int64_t>{1, 11017, -1}));
+}
+
+TEST_F(CsvLoaderTest, ChunkingDoesNotChangeResult) {
+    std::mt19937_64 rng(5);
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        std::string name;
+        switch (rng() % 4) {
+            case 0: name = "plain" + std::to_string(i); break;
+            case 1: name = "\"with, comma\""; break;
+            case 2: name = "\"line\nbreak \"\"quoted\"\"\n\""; break;
+            default: name = ""; break;
+        }
+        text += std::to_string(i) + "," + name + "," + std::to_string(i * 0.25) + "," +
+                (i % 2 ? "t" : "false") + ",2024-02-29" + (i % 3 ? "\n" : "\r\n");
+    }
+    
+    CsvOptions serial;
+    serial.num_threads = 1;
+    serial.chunk_bytes = text.size();
+    TableData expected = load(text, serial);
+    ASSERT_EQ(expected.rowCount(), 2000);
+    
+    for (size_t chunk_bytes : {1, 7, 64, 4096}) {
+        for (size_t threads : {1, 4}) {
+            CsvOptions options;
+            options.num_threads = threads;
+            options.chunk_bytes = chunk_bytes;
+            expectSameRows(load(text, options), expected);
+        }
+    }
+}
+
+TEST_F(CsvLoaderTest, LoadsMappedFileAndAppends) {
+    auto path = std::filesystem::temp_directory_path() / "csv_loader_test.csv";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "1,a,1.5,true,2001-01-01\n2,b,2.5,false,2001-01-02\n";
+    }
+    
+    TableData data(table);
+    CsvOptions options;
+    options.delimiter = '|';
+    CsvLoader(table, options).load("0|z|0|0|2000-01-01\n", data);
+    EXPECT_EQ(CsvLoader(table).loadFile(path.string(), data), 2);
+    std::filesystem::remove(path);
+    
+    EXPECT_EQ(data.columns[0].integers(), (std::vector<int64_t>{0, 1, 2}));
+    EXPECT_EQ(data.columns[1].strings(), (std::vector<std::string>{"z", "a", "b"}));
+    EXPECT_THROW(CsvLoader(table).loadFile(path.string(), data), std::runtime_error);
+}
+
+TEST_F(CsvLoaderTest, ReportsMalformedInput) {
+    EXPECT_EQ(loadError("1,a,1,t,2000-01-01\n2,b,1,t\n"), "CSV line 2: Expected 5 fields, got 4");
+    EXPECT_EQ(loadError("1,a,1,t,2000-01-01,x\n"), "CSV line 1: Expected 5 fields, got more");
+    EXPECT_EQ(loadError("x,a,1,t,2000-01-01\n"), "CSV line 1: Invalid INTEGER value 'x' for column id");
+    EXPECT_EQ(loadError("1,a,1,t,2000-02-30\n"), "CSV line 1: Invalid DATE value '2000-02-30' for column born");
+    EXPECT_EQ(loadError("1,a,,t,2000-01-01\n"), "CSV line 1: NULL values are not supported (column score)");
+    EXPECT_EQ(loadError("1,\"a,1,t,2000-01-01\n"), "CSV line 1: Unterminated quoted field");
+    EXPECT_EQ(loadError("1,a\"b,1,t,2000-01-01\n"), "CSV line 1: Unexpected quote in unquoted field");
+    EXPECT_EQ(loadError("1,\"a\"b,1,t,2000-01-01\n"), "CSV line 1: Unexpected character after quoted field");
+    EXPECT_EQ(loadError("1,a,1,yes,2000-01-01\n"), "CSV line 1: Invalid BOOLEAN value 'yes' for column active");
+    
+    TableData wrong(std::vector<DataType>{DataType::INTEGER});
+    EXPECT_THROW(CsvLoader(table).load("1\n", wrong), std::runtime_error);
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "parser/incremental.h"
+#include "parser/lexer.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+
+class IncrementalParserTest : public ::testing::Test {
+protected:
+    // The incremental state must always match a from-scratch parse.
+    void expectMatchesFullParse(const IncrementalParser& incremental) {
+        IncrementalParser fresh(incremental.text());
+        
+        const auto& tokens = incremental.tokens();
+        const auto& expected_tokens = fresh.tokens();
+        ASSERT_EQ(tokens.size(), expected_tokens.size()) << incremental.text();
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            EXPECT_EQ(tokens[i].type, expected_tokens[i].type) << incremental.text();
+            EXPECT_EQ(tokens[i].value, expected_tokens[i].value);
+            EXPECT_EQ(tokens[i].position, expected_tokens[i].position);
+            EXPECT_EQ(tokens[i].length, expected_tokens[i].length);
+        }
+        
+        const auto& statements = incremental.statements();
+        const auto& expected_statements = fresh.statements();
+        ASSERT_EQ(statements.size(), expected_statements.size()) << incremental.text();
+        for (size_t i = 0; i < statements.size(); ++i) {
+            EXPECT_EQ(statements[i].first_token, expected_statements[i].first_token);
+            EXPECT_EQ(statements[i].end_token, expected_statements[i].end_token);
+            EXPECT_EQ(statements[i].error, expected_statements[i].error);
+            ASSERT_EQ(statements[i].ast == nullptr, expected_statements[i].ast == nullptr);
+            if (statements[i].ast) {
+                EXPECT_EQ(statements[i].ast->toString(), expected_statements[i].ast->toString());
+            }
+        }
+    }
+};
+
+TEST_F(IncrementalParserTest, ParsesScriptIntoStatements) {
+    IncrementalParser parser("SELECT a FROM t; INSERT INTO t VALUES (1);; SELECT");
+    
+    const auto& statements = parser.statements();
+    ASSERT_EQ(statements.size(), 3);
+    EXPECT_EQ(statements[0].ast->toString(), "SELECT Column(a) FROM t");
+    EXPECT_EQ(statements[1].ast->toString(), "INSERT INTO t VALUES (1)");
+    EXPECT_EQ(statements[2].ast, nullptr);
+    EXPECT_EQ(statements[2].error, "Expected column name or *");
+}
+
+TEST_F(IncrementalParserTest, EditReusesUntouchedStatements) {
+    std::string sql;
+    for (int i = 0; i < 100; ++i) {
+        sql += "SELECT c" + std::to_string(i) + " FROM t WHERE x > " + std::to_string(i) + ";\n";
+    }
+    IncrementalParser parser(sql);
+    const Statement* first_before = parser.statements().front().ast;
+    const Statement* last_before = parser.statements().back().ast;
+    
+    size_t offset = parser.text().find("c50 ");
+    parser.applyEdit({offset, 3, "renamed"});
+    
+    EXPECT_EQ(parser.lastReparsedStatementCount(), 1);
+    EXPECT_LE(parser.lastRelexedTokenCount(), 2);
+    EXPECT_EQ(parser.statements().front().ast, first_before);
+    EXPECT_EQ(parser.statements().back().ast, last_before);
+    EXPECT_EQ(parser.statements()[50].ast->toString(),
+              "SELECT Column(renamed) FROM t WHERE (Column(x) > 50)");
+    expectMatchesFullParse(parser);
+}
+
+TEST_F(IncrementalParserTest, EditCostDoesNotGrowWithScriptLength) {
+    // Best of three rounds of typing and deleting a word in the middle
+    // statement, in microseconds.
+    auto editTime = [](int statement_count) {
+        std::string sql;
+        for (int i = 0; i < statement_count; ++i) {
+            sql += "SELECT c" + std::to_string(i) + " FROM t WHERE x > " + std::to_string(i) + ";\n";
+        }
+        IncrementalParser parser(sql);
+        size_t offset = parser.text().find("c" + std::to_string(statement_count / 2) + " ");
+        
+        long long best = -1;
+        for (int round = 0; round < 3; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < 200; ++i) {
+                parser.applyEdit({offset, 0, "x"});
+                parser.applyEdit({offset, 1, ""});
+            }
+            long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            best = best < 0 ? elapsed : std::min(best, elapsed);
+        }
+        EXPECT_EQ(parser.lastReparsedStatementCount(), 1);
+        return best;
+    };
+    
+    long long small = editTime(1000);
+    long long large = editTime(64000);
+    EXPECT_LT(large, small * 4 + 5000) << "1000 statements: " << small << "us, 64000 statements: " << large << "us";
+}
+
+TEST_F(IncrementalParserTest, EditsThatMergeAndSplitTokens) {
+    IncrementalParser parser("SELECT a FROM t WHERE x < 1");
+    
+    parser.applyEdit({parser.text().find('<') + 1, 0, "="});
+    expectMatchesFullParse(parser);
+    EXPECT_EQ(parser.statements()[0].ast->toString(),
+              "SELECT Column(a) FROM t WHERE (Column(x) <= 1)");
+    
+    parser.applyEdit({parser.text().find("FROM") - 1, 1, ""});
+    expectMatchesFullParse(parser);
+    EXPECT_EQ(parser.statements()[0].error, "Expected FROM keyword");
+    
+    parser.applyEdit({parser.text().find("FROM"), 0, " "});
+    expectMatchesFullParse(parser);
+    EXPECT_TRUE(parser.statements()[0].error.empty());
+}
+
+TEST_F(IncrementalParserTest, EditsThatChangeStatementBoundaries) {
+    IncrementalParser parser("SELECT a FROM t; SELECT b FROM u; SELECT c FROM v");
+    
+    parser.applyEdit({parser.text().find(';'), 1, ""});
+    expectMatchesFullParse(parser);
+    EXPECT_EQ(parser.statements().size(), 2);
+    
+    parser.applyEdit({parser.text().find(" SELECT b"), 0, ";"});
+    expectMatchesFullParse(parser);
+    EXPECT_EQ(parser.statements().size(), 3);
+}
+
+TEST_F(IncrementalParserTest, UnterminatedStringSwallowsRestOfBuffer) {
+    IncrementalParser parser("SELECT a FROM t WHERE s = 'x'; SELECT b FROM u");
+    
+    parser.applyEdit({parser.text().find("'x'"), 1, ""});
+    expectMatchesFullParse(parser);
+    
+    parser.applyEdit({parser.text().find("x'"), 0, "'"});
+    expectMatchesFullParse(parser);
+    EXPECT_EQ(parser.statements().size(), 2);
+}
+
+TEST_F(IncrementalParserTest, RejectsEditOutsideBuffer) {
+    IncrementalParser parser("SELECT a FROM t");
+    EXPECT_THROW(parser.applyEdit({100, 0, "x"}), std::out_of_range);
+    EXPECT_THROW(parser.applyEdit({10, 10, ""}), std::out_of_range);
+}
+
+TEST_F(IncrementalParserTest, RandomEditsMatchFullParse) {
+    const std::string fragments[] = {
+        "SELECT ", "FROM ", "WHERE ", "a", "b1", " ", ";", "'", "'str'", "<", "=",
+        ">", "!", "(", ")", ",", "12", ".5", "AND ", "OR ", "INSERT INTO t VALUES (1, 'x')",
+        "\n", "*", "\\"
+    };
+    std::mt19937 rng(42);
+    IncrementalParser parser("SELECT a, b FROM t WHERE a > 1; INSERT INTO t VALUES (1, 'x');");
+    
+    for (int i = 0; i < 2000; ++i) {
+        const std::string& text = parser.text();
+        size_t offset = std::uniform_int_distribution<size_t>(0, text.size())(rng);
+        size_t max_removed = std::min<size_t>(text.size() - offset, 6);
+        size_t removed = std::uniform_int_distribution<size_t>(0, max_removed)(rng);
+        std::string inserted;
+        if (rng() % 4 != 0) {
+            inserted = fragments[rng() % (sizeof(fragments) / sizeof(fragments[0]))];
+        }
+        parser.applyEdit({offset, removed, inserted});
+        expectMatchesFullParse(parser);
+        if (HasFailure()) {
+            FAIL() << "after edit " << i << " at " << offset << ": " << parser.text();
+        }
+    }
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "execution/hash_join.h"
+#include "execution/hashing.h"
+#include <atomic>
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+class HashJoinTest : public ::testing::Test {
+protected:
+    using RowPairs = std::vector<std::pair<size_t, size_t>>;
+
+    RowPairs runJoin(const ColumnData& build, const ColumnData& probe, JoinOptions options) {
+        HashJoin join(options);
+        join.build(build);
+        
+        RowPairs pairs;
+        std::mutex mutex;
+        join.probe(probe, [&](const JoinBatch& batch) {
+            EXPECT_LE(batch.size(), options.batch_size);
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                pairs.emplace_back(batch.build_rows[i], batch.probe_rows[i]);
+            }
+        });
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+
+    RowPairs nestedLoopJoin(const ColumnData& build, const ColumnData& probe) {
+        RowPairs pairs;
+        for (size_t b = 0; b < build.size(); ++b) {
+            for (size_t p = 0; p < probe.size(); ++p) {
+                bool equal = build.kind() == StorageKind::STRING
+                                 ? build.stringAt(b) == probe.stringAt(p)
+                                 : build.integerAt(b) == probe.integerAt(p);
+                if (equal) pairs.emplace_back(b, p);
+            }
+        }
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+};
+
+TEST_F(HashJoinTest, IntegerKeysWithDuplicates) {
+    std::mt19937_64 rng(3);
+    ColumnData build(DataType::INTEGER);
+    ColumnData probe(DataType::INTEGER);
+    for (int i = 0; i < 3000; ++i) build.appendInteger(static_cast<int64_t>(rng() % 1000));
+    for (int i = 0; i < 2000; ++i) probe.appendInteger(static_cast<int64_t>(rng() % 4000) - 500);
+    
+    RowPairs expected = nestedLoopJoin(build, probe);
+    ASSERT_FALSE(expected.empty());
+    
+    for (size_t threads : {1, 4}) {
+        for (size_t radix_bits : {0, 3}) {
+            JoinOptions options;
+            options.num_threads = threads;
+            options.radix_bits = radix_bits;
+            options.batch_size = 64;
+            EXPECT_EQ(runJoin(build, probe, options), expected);
+        }
+    }
+}
+
+TEST_F(HashJoinTest, StringKeys) {
+    ColumnData build(DataType::VARCHAR);
+    ColumnData probe(DataType::VARCHAR);
+    for (int i = 0; i < 200; ++i) build.appendString("key" + std::to_string(i % 50));
+    for (int i = 0; i < 300; ++i) probe.appendString("key" + std::to_string(i % 120));
+    
+    JoinOptions options;
+    options.num_threads = 3;
+    EXPECT_EQ(runJoin(build, probe, options), nestedLoopJoin(build, probe));
+}
+
+TEST_F(HashJoinTest, BloomFilterRejectsMostMisses) {
+    ColumnData build(DataType::INTEGER);
+    ColumnData probe(DataType::INTEGER);
+    for (int64_t i = 0; i < 10000; ++i) build.appendInteger(i);
+    for (int64_t i = 0; i < 20000; ++i) probe.appendInteger(i);
+    
+    JoinOptions options;
+    options.num_threads = 2;
+    HashJoin join(options);
+    join.build(build);
+    ASSERT_NE(join.bloomFilter(), nullptr);
+    for (int64_t i = 0; i < 10000; ++i) {
+        ColumnData key(DataType::INTEGER);
+        key.appendInteger(i);
+        EXPECT_TRUE(join.bloomFilter()->mayContain(hashValue(key, 0)));
+    }
+    
+    std::atomic<size_t> matches{0};
+    join.probe(probe, [&](const JoinBatch& batch) { matches += batch.size(); });
+    EXPECT_EQ(matches.load(), 10000);
+    // 10000 probe keys miss; at 16 bits per key nearly all are filtered.
+    EXPECT_GT(join.filteredProbeRows(), 9800);
+    EXPECT_LE(join.filteredProbeRows(), 10000);
+    
+    // The pushed-down scan keeps every matching row and drops the rest
+    // before the join sees them.
+    std::vector<size_t> rows = join.filterProbeRows(probe);
+    EXPECT_EQ(rows.size(), probe.size() - join.filteredProbeRows());
+    EXPECT_TRUE(std::is_sorted(rows.begin(), rows.end()));
+    for (size_t i = 0; i < 10000; ++i) {
+        EXPECT_EQ(rows[i], i);
+    }
+    matches = 0;
+    join.probe(probe, rows, [&](const JoinBatch& batch) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            EXPECT_EQ(batch.build_rows[i], batch.probe_rows[i]);
+        }
+        matches += batch.size();
+    });
+    EXPECT_EQ(matches.load(), 10000);
+}
+
+TEST_F(HashJoinTest, EmptySidesAndErrors) {
+    ColumnData empty(DataType::INTEGER);
+    ColumnData keys(DataType::INTEGER);
+    keys.appendInteger(1);
+    
+    JoinOptions options;
+    EXPECT_TRUE(runJoin(empty, keys, options).empty());
+    EXPECT_TRUE(runJoin(keys, empty, options).empty());
+    
+    HashJoin unbuilt(options);
+    EXPECT_THROW(unbuilt.probe(keys, [](const JoinBatch&) {}), std::runtime_error);
+    
+    HashJoin join(options);
+    join.build(keys);
+    ColumnData strings(DataType::VARCHAR);
+    EXPECT_THROW(join.probe(strings, [](const JoinBatch&) {}), std::runtime_error);
+}
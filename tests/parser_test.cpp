@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "parser/lexer.h"
+#include "parser/parser.h"
+
+class ParserTest : public ::testing::Test {
+protected:
+    std::unique_ptr<Statement> parse(const std::string& sql) {
+        Lexer lexer(sql);
+        Parser parser(lexer.tokenize());
+        return parser.parse();
+    }
+
+    std::unique_ptr<SelectStatement> parseSelect(const std::string& sql) {
+        auto stmt = parse(sql);
+        auto* select = dynamic_cast<SelectStatement*>(stmt.get());
+        EXPECT_NE(select, nullptr);
+        stmt.release();
+        return std::unique_ptr<SelectStatement>(select);
+    }
+};
+
+TEST_F(ParserTest, ParseSimpleSelect) {
+    auto stmt = parseSelect("SELECT name, age FROM users WHERE age > 18");
+    
+    ASSERT_EQ(stmt->columns.size(), 2);
+    EXPECT_EQ(stmt->table_name, "users");
+    EXPECT_EQ(stmt->toString(), "SELECT Column(name), Column(age) FROM users WHERE (Column(age) > 18)");
+}
+
+TEST_F(ParserTest, ParseInsert) {
+    auto stmt = parse("INSERT INTO users (id, name) VALUES (1, 'Alice')");
+    EXPECT_EQ(stmt->toString(), "INSERT INTO users (id, name) VALUES (1, 'Alice')");
+}
+
+TEST_F(ParserTest, ParseAggregates) {
+    auto stmt = parseSelect("SELECT COUNT(*), sum(salary), MIN(age), Max(age), AVG(salary) FROM emp");
+    
+    ASSERT_EQ(stmt->columns.size(), 5);
+    auto* count = dynamic_cast<AggregateExpression*>(stmt->columns[0].get());
+    ASSERT_NE(count, nullptr);
+    EXPECT_EQ(count->function, AggregateExpression::Function::COUNT);
+    EXPECT_EQ(count->argument, nullptr);
+    EXPECT_EQ(stmt->toString(),
+              "SELECT COUNT(*), SUM(Column(salary)), MIN(Column(age)), MAX(Column(age)), "
+              "AVG(Column(salary)) FROM emp");
+}
+
+TEST_F(ParserTest, ParseGroupBy) {
+    auto stmt = parseSelect("SELECT dept, region, COUNT(id) FROM emp GROUP BY dept, region");
+    
+    ASSERT_EQ(stmt->group_by.size(), 2);
+    EXPECT_EQ(stmt->toString(),
+              "SELECT Column(dept), Column(region), COUNT(Column(id)) FROM emp "
+              "GROUP BY Column(dept), Column(region)");
+}
+
+TEST_F(ParserTest, GroupByErrors) {
+    EXPECT_THROW(parse("SELECT a FROM t GROUP a"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT a FROM t GROUP BY"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT MEDIAN(a) FROM t"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT SUM(*) FROM t"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT COUNT(a FROM t"), std::runtime_error);
+}
+
+TEST_F(ParserTest, ParseJoinWithQualifiedColumns) {
+    auto stmt = parseSelect("SELECT users.name, o.total FROM users JOIN orders ON users.id = orders.user_id "
+                            "WHERE o.total > 10");
+    
+    ASSERT_EQ(stmt->joins.size(), 1);
+    EXPECT_EQ(stmt->joins[0].table_name, "orders");
+    auto* col = dynamic_cast<ColumnExpression*>(stmt->columns[0].get());
+    ASSERT_NE(col, nullptr);
+    EXPECT_EQ(col->table_name, "users");
+    EXPECT_EQ(col->column_name, "name");
+    EXPECT_EQ(stmt->toString(),
+              "SELECT Column(users.name), Column(o.total) FROM users "
+              "JOIN orders ON (Column(users.id) = Column(orders.user_id)) "
+              "WHERE (Column(o.total) > 10)");
+}
+
+TEST_F(ParserTest, ParseInnerJoinChain) {
+    auto stmt = parseSelect("SELECT a FROM t1 INNER JOIN t2 ON x = y JOIN t3 ON t2.z = t3.z");
+    ASSERT_EQ(stmt->joins.size(), 2);
+    EXPECT_EQ(stmt->joins[1].table_name, "t3");
+}
+
+TEST_F(ParserTest, JoinErrors) {
+    EXPECT_THROW(parse("SELECT a FROM t JOIN u"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT a FROM t INNER u ON a = b"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT a FROM t JOIN ON a = b"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT t. FROM t"), std::runtime_error);
+}
+
+TEST_F(ParserTest, ParseOrderByAndLimit) {
+    auto stmt = parseSelect("SELECT name FROM emp ORDER BY dept, age DESC, name ASC LIMIT 10");
+    
+    ASSERT_EQ(stmt->order_by.size(), 3);
+    EXPECT_FALSE(stmt->order_by[0].descending);
+    EXPECT_TRUE(stmt->order_by[1].descending);
+    EXPECT_FALSE(stmt->order_by[2].descending);
+    ASSERT_TRUE(stmt->limit.has_value());
+    EXPECT_EQ(*stmt->limit, 10);
+    EXPECT_EQ(stmt->toString(),
+              "SELECT Column(name) FROM emp ORDER BY Column(dept), Column(age) DESC, Column(name) LIMIT 10");
+    
+    EXPECT_FALSE(parseSelect("SELECT a FROM t")->limit.has_value());
+    EXPECT_EQ(*parseSelect("SELECT a FROM t LIMIT 0")->limit, 0);
+}
+
+TEST_F(ParserTest, OrderByErrors) {
+    EXPECT_THROW(parse("SELECT a FROM t ORDER a"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT a FROM t ORDER BY"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT a FROM t LIMIT"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT a FROM t LIMIT 1.5"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT a FROM t LIMIT 'x'"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT a FROM t LIMIT 99999999999999999999999"), std::runtime_error);
+}
+
+TEST_F(ParserTest, ParseCopy) {
+    auto stmt = parse("COPY users FROM '/data/users.csv'");
+    auto* copy = dynamic_cast<CopyStatement*>(stmt.get());
+    ASSERT_NE(copy, nullptr);
+    EXPECT_EQ(copy->table_name, "users");
+    EXPECT_EQ(copy->file_path, "/data/users.csv");
+    EXPECT_EQ(stmt->toString(), "COPY users FROM '/data/users.csv'");
+    
+    EXPECT_THROW(parse("COPY FROM 'x.csv'"), std::runtime_error);
+    EXPECT_THROW(parse("COPY users 'x.csv'"), std::runtime_error);
+    EXPECT_THROW(parse("COPY users FROM x"), std::runtime_error);
+}
+
+TEST_F(ParserTest, NestingDepthIsLimited) {
+    const size_t limit = Parser::MAX_NESTING_DEPTH;
+    std::string nested = std::string(limit - 1, '(') + "a" + std::string(limit - 1, ')');
+    EXPECT_NO_THROW(parse("SELECT a FROM t WHERE " + nested));
+    EXPECT_THROW(parse("SELECT a FROM t WHERE (" + nested + ")"), std::runtime_error);
+    EXPECT_THROW(parse("SELECT a FROM t WHERE " + std::string(1000000, '(') + "1"), std::runtime_error);
+    
+    std::string aggregate = "a";
+    for (size_t i = 0; i < limit; ++i) aggregate = "SUM(" + aggregate + ")";
+    EXPECT_THROW(parse("SELECT " + aggregate + " FROM t"), std::runtime_error);
+}
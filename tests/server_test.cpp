@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+#include "server/protocol.h"
+#include "server/server.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <memory>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+class ServerTest : public ::testing::Test {
+protected:
+    std::unique_ptr<Server> server;
+    std::thread loop;
+
+    void SetUp() override {
+        startServer(ServerConfig());
+    }
+
+    void TearDown() override {
+        stopServer();
+    }
+
+    void startServer(ServerConfig config) {
+        config.port = 0;
+        config.worker_threads = 4;
+        server = std::make_unique<Server>(config);
+        server->start();
+        loop = std::thread([this] { server->run(); });
+    }
+
+    void stopServer() {
+        server->stop();
+        loop.join();
+        server.reset();
+    }
+
+    int connectClient() {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(server->port());
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        EXPECT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+        return fd;
+    }
+
+    static void sendAll(int fd, const std::string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = send(fd, data.data() + sent, data.size() - sent, 0);
+            ASSERT_GT(n, 0);
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    std::vector<std::string> readResponses(int fd, size_t count) {
+        std::vector<std::string> responses;
+        std::string buffer;
+        size_t offset = 0;
+        std::string payload;
+        char chunk[4096];
+        while (responses.size() < count) {
+            if (readFrame(buffer, offset, payload)) {
+                responses.push_back(payload);
+                continue;
+            }
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) break;
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+        return responses;
+    }
+};
+
+TEST(ProtocolTest, FramesRoundTrip) {
+    std::string buffer;
+    appendFrame(buffer, "SELECT a FROM t");
+    appendFrame(buffer, "");
+    appendResponseFrame(buffer, ResponseStatus::ERROR, "bad");
+    
+    size_t offset = 0;
+    std::string payload;
+    ASSERT_TRUE(readFrame(buffer, offset, payload));
+    EXPECT_EQ(payload, "SELECT a FROM t");
+    ASSERT_TRUE(readFrame(buffer, offset, payload));
+    EXPECT_EQ(payload, "");
+    ASSERT_TRUE(readFrame(buffer, offset, payload));
+    EXPECT_EQ(payload, "Ebad");
+    EXPECT_FALSE(readFrame(buffer, offset, payload));
+    EXPECT_EQ(offset, buffer.size());
+}
+
+TEST(ProtocolTest, PartialFrameIsNotConsumed) {
+    std::string buffer;
+    appendFrame(buffer, "SELECT a FROM t");
+    std::string partial = buffer.substr(0, buffer.size() - 1);
+    
+    size_t offset = 0;
+    std::string payload;
+    EXPECT_FALSE(readFrame(partial, offset, payload));
+    EXPECT_EQ(offset, 0);
+}
+
+TEST(ProtocolTest, RejectsOversizedFrame) {
+    std::string buffer("\xFF\xFF\xFF\xFF", 4);
+    size_t offset = 0;
+    std::string payload;
+    EXPECT_THROW(readFrame(buffer, offset, payload), std::runtime_error);
+}
+
+TEST_F(ServerTest, PipelinedResponsesArriveInOrder) {
+    int fd = connectClient();
+    
+    const size_t count = 200;
+    std::string requests;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 7 == 3) {
+            appendFrame(requests, "DROP TABLE t" + std::to_string(i));
+        } else {
+            appendFrame(requests, "SELECT c" + std::to_string(i) + " FROM t");
+        }
+    }
+    ASSERT_EQ(send(fd, requests.data(), requests.size(), 0),
+              static_cast<ssize_t>(requests.size()));
+    
+    auto responses = readResponses(fd, count);
+    ASSERT_EQ(responses.size(), count);
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 7 == 3) {
+            EXPECT_EQ(responses[i], "EExpected SELECT, INSERT or COPY statement");
+        } else {
+            EXPECT_EQ(responses[i], "KSELECT Column(c" + std::to_string(i) + ") FROM t");
+        }
+    }
+    close(fd);
+}
+
+TEST_F(ServerTest, ServesConcurrentClients) {
+    std::vector<std::thread> clients;
+    std::vector<char> ok(8, 0);
+    for (size_t c = 0; c < ok.size(); ++c) {
+        clients.emplace_back([this, c, &ok] {
+            int fd = connectClient();
+            std::string requests;
+            for (int i = 0; i < 50; ++i) {
+                appendFrame(requests, "INSERT INTO t VALUES (" + std::to_string(c) + ", " +
+                                      std::to_string(i) + ")");
+            }
+            send(fd, requests.data(), requests.size(), 0);
+            auto responses = readResponses(fd, 50);
+            bool all_ok = responses.size() == 50;
+            for (int i = 0; all_ok && i < 50; ++i) {
+                all_ok = responses[i] == "KINSERT INTO t VALUES (" + std::to_string(c) + ", " +
+                                         std::to_string(i) + ")";
+            }
+            ok[c] = all_ok;
+            close(fd);
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    for (char client_ok : ok) {
+        EXPECT_TRUE(client_ok);
+    }
+}
+
+TEST_F(ServerTest, HalfClosedClientStillGetsResponses) {
+    int fd = connectClient();
+    std::string requests;
+    appendFrame(requests, "SELECT a FROM t");
+    appendFrame(requests, "SELECT b FROM t");
+    send(fd, requests.data(), requests.size(), 0);
+    shutdown(fd, SHUT_WR);
+    
+    auto responses = readResponses(fd, 2);
+    ASSERT_EQ(responses.size(), 2);
+    EXPECT_EQ(responses[1], "KSELECT Column(b) FROM t");
+    close(fd);
+}
+
+TEST_F(ServerTest, DeeplyNestedExpressionIsRejected) {
+    int fd = connectClient();
+    std::string requests;
+    appendFrame(requests, "SELECT a FROM t WHERE " + std::string(2000000, '(') + "1");
+    appendFrame(requests, "SELECT b FROM t");
+    sendAll(fd, requests);
+    
+    auto responses = readResponses(fd, 2);
+    ASSERT_EQ(responses.size(), 2);
+    EXPECT_EQ(responses[0], "EExpression nesting is deeper than 256");
+    EXPECT_EQ(responses[1], "KSELECT Column(b) FROM t");
+    close(fd);
+}
+
+TEST_F(ServerTest, AnswersEveryRequestUnderInflightLimit) {
+    stopServer();
+    ServerConfig config;
+    config.max_inflight_requests = 3;
+    startServer(config);
+    
+    int fd = connectClient();
+    timeval timeout{10, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    const size_t count = 5000;
+    std::string requests;
+    for (size_t i = 0; i < count; ++i) {
+        appendFrame(requests, "SELECT c" + std::to_string(i) + " FROM t");
+    }
+    // Most frames wait in the read buffer and are only dispatched as earlier
+    // responses go out.
+    std::thread sender([&] { sendAll(fd, requests); });
+    auto responses = readResponses(fd, count);
+    sender.join();
+    ASSERT_EQ(responses.size(), count);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(responses[i], "KSELECT Column(c" + std::to_string(i) + ") FROM t");
+    }
+    close(fd);
+}
+
+TEST_F(ServerTest, StopsReadingAtWriteBufferLimit) {
+    stopServer();
+    ServerConfig config;
+    config.max_write_buffer_bytes = 64 * 1024;
+    startServer(config);
+    
+    std::string sql = "SELECT c0";
+    std::string ast = "KSELECT Column(c0)";
+    for (int i = 1; i < 200; ++i) {
+        sql += ", c" + std::to_string(i);
+        ast += ", Column(c" + std::to_string(i) + ")";
+    }
+    const size_t count = 16000;
+    std::string requests;
+    for (size_t i = 0; i < count; ++i) {
+        appendFrame(requests, sql + " FROM t");
+    }
+    
+    int fd = connectClient();
+    int buffer_size = 64 * 1024;
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    int flags = fcntl(fd, F_GETFL);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    
+    // Never reading a response, the client only gets as far as the socket
+    // buffers plus what the server takes in before it stops reading. A server
+    // that kept reading would swallow everything.
+    size_t sent = 0;
+    pollfd writable{fd, POLLOUT, 0};
+    while (sent < requests.size() && poll(&writable, 1, 300) > 0) {
+        ssize_t n = send(fd, requests.data() + sent, requests.size() - sent, 0);
+        if (n > 0) sent += static_cast<size_t>(n);
+    }
+    EXPECT_LT(sent, requests.size() / 2);
+    
+    fcntl(fd, F_SETFL, flags);
+    std::thread sender([&] { sendAll(fd, requests.substr(sent)); });
+    auto responses = readResponses(fd, count);
+    sender.join();
+    ASSERT_EQ(responses.size(), count);
+    EXPECT_EQ(responses.back(), ast + " FROM t");
+    close(fd);
+}
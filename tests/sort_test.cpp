@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "execution/sort.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+// Lowers the soft limit on open files for the lifetime of the object.
+class OpenFileLimit {
+public:
+    explicit OpenFileLimit(rlim_t limit) {
+        getrlimit(RLIMIT_NOFILE, &saved);
+        rlimit lowered = saved;
+        lowered.rlim_cur = std::min(limit, saved.rlim_cur);
+        setrlimit(RLIMIT_NOFILE, &lowered);
+    }
+    ~OpenFileLimit() { setrlimit(RLIMIT_NOFILE, &saved); }
+
+private:
+    rlimit saved;
+};
+
+class SortTest : public ::testing::Test {
+protected:
+    TableInfo table{"t", 0};
+    TableData data;
+
+    void SetUp() override {
+        table.addColumn(ColumnInfo("a", DataType::INTEGER, 0));
+        table.addColumn(ColumnInfo("b", DataType::FLOAT, 1));
+        table.addColumn(ColumnInfo("c", DataType::VARCHAR, 2));
+        data = TableData(table);
+        
+        std::mt19937_64 rng(11);
+        std::vector<std::string> words = {"", "a", "ab", "b", std::string("a\0b", 3), std::string("a\0", 2), "zz"};
+        for (int i = 0; i < 5000; ++i) {
+            data.columns[0].appendInteger(static_cast<int64_t>(rng() % 200) - 100);
+            data.columns[1].appendFloat(static_cast<double>(static_cast<int64_t>(rng() % 41) - 20) / 4.0);
+            data.columns[2].appendString(words[rng() % words.size()]);
+        }
+        data.columns[0].appendInteger(INT64_MIN);
+        data.columns[0].appendInteger(INT64_MAX);
+        data.columns[1].appendFloat(-0.0);
+        data.columns[1].appendFloat(-1e300);
+        data.columns[2].appendString("");
+        data.columns[2].appendString("zzz");
+    }
+
+    SortPlan makePlan(std::vector<SortKey> keys, std::optional<size_t> limit = std::nullopt) {
+        SortPlan plan;
+        plan.table = &table;
+        plan.keys = std::move(keys);
+        plan.limit = limit;
+        for (const ColumnInfo& info : table.columns) {
+            plan.outputs.push_back({info.column_id, info.name, info.type});
+        }
+        return plan;
+    }
+
+    int compareRows(const SortKey& key, size_t x, size_t y) {
+        const ColumnData& column = data.columns[key.column_id];
+        int result;
+        switch (column.kind()) {
+            case StorageKind::INTEGER:
+                result = (column.integerAt(x) > column.integerAt(y)) - (column.integerAt(x) < column.integerAt(y));
+                break;
+            case StorageKind::FLOAT:
+                result = (column.floatAt(x) > column.floatAt(y)) - (column.floatAt(x) < column.floatAt(y));
+                break;
+            default:
+                result = column.stringAt(x).compare(column.stringAt(y));
+                result = (result > 0) - (result < 0);
+                break;
+        }
+        return key.descending ? -result : result;
+    }
+
+    std::vector<size_t> referenceSort(const SortPlan& plan) {
+        std::vector<size_t> rows(data.rowCount());
+        std::iota(rows.begin(), rows.end(), 0);
+        std::stable_sort(rows.begin(), rows.end(), [&](size_t x, size_t y) {
+            for (const SortKey& key : plan.keys) {
+                int cmp = compareRows(key, x, y);
+                if (cmp != 0) return cmp < 0;
+            }
+            return false;
+        });
+        if (plan.limit && *plan.limit < rows.size()) rows.resize(*plan.limit);
+        return rows;
+    }
+};
+
+TEST_F(SortTest, MatchesStableSortForEveryKeyKind) {
+    std::vector<std::vector<SortKey>> key_sets = {
+        {{0, DataType::INTEGER, false}},
+        {{1, DataType::FLOAT, true}},
+        {{2, DataType::VARCHAR, false}},
+        {{2, DataType::VARCHAR, true}, {1, DataType::FLOAT, false}, {0, DataType::INTEGER, true}},
+    };
+    for (const auto& keys : key_sets) {
+        SortPlan plan = makePlan(keys);
+        for (size_t threads : {1, 4}) {
+            SortOptions options;
+            options.num_threads = threads;
+            Sorter sorter(plan, options);
+            EXPECT_EQ(sorter.sortedRows(data), referenceSort(plan));
+            EXPECT_EQ(sorter.spilledRunCount(), 0);
+        }
+    }
+}
+
+TEST_F(SortTest, TopKMatchesFullSort) {
+    std::vector<SortKey> keys = {{1, DataType::FLOAT, false}, {2, DataType::VARCHAR, true}};
+    for (size_t limit : {1, 7, 100, 6000}) {
+        SortPlan plan = makePlan(keys, limit);
+        for (size_t threshold : {0, 10000}) {
+            SortOptions options;
+            options.num_threads = 3;
+            options.top_k_threshold = threshold;
+            EXPECT_EQ(Sorter(plan, options).sortedRows(data), referenceSort(plan));
+        }
+    }
+}
+
+TEST_F(SortTest, SpillsRunsOverMemoryBudget) {
+    SortPlan plan = makePlan({{0, DataType::INTEGER, true}, {2, DataType::VARCHAR, false}});
+    for (size_t threads : {1, 4}) {
+        SortOptions options;
+        options.num_threads = threads;
+        options.memory_budget_bytes = 16 * 1024;
+        Sorter sorter(plan, options);
+        EXPECT_EQ(sorter.sortedRows(data), referenceSort(plan));
+        EXPECT_GT(sorter.spilledRunCount(), 4);
+    }
+    
+    // One spilled run per row, far more than there are file descriptors.
+    OpenFileLimit file_limit(1024);
+    plan.limit = 20000;
+    SortOptions options;
+    options.memory_budget_bytes = 1;
+    Sorter sorter(plan, options);
+    EXPECT_EQ(sorter.sortedRows(data), referenceSort(plan));
+    EXPECT_EQ(sorter.spilledRunCount(), data.rowCount());
+}
+
+TEST_F(SortTest, MergesInPassesAboveFanIn) {
+    OpenFileLimit file_limit(1024);
+    SortPlan plan = makePlan({{2, DataType::VARCHAR, true}, {1, DataType::FLOAT, false}});
+    for (size_t fan_in : {0, 2, 3, 7}) {
+        for (size_t threads : {1, 4}) {
+            SortOptions options;
+            options.num_threads = threads;
+            options.memory_budget_bytes = 2 * 1024;
+            options.max_merge_fan_in = fan_in;
+            Sorter sorter(plan, options);
+            EXPECT_EQ(sorter.sortedRows(data), referenceSort(plan)) << fan_in << " " << threads;
+            EXPECT_GT(sorter.spilledRunCount(), fan_in);
+        }
+    }
+}
+
+TEST_F(SortTest, ExecuteMaterializesSortedRows) {
+    SortPlan plan = makePlan({{0, DataType::INTEGER, false}}, 3);
+    TableData result = Sorter(plan).execute(data);
+    
+    ASSERT_EQ(result.columns.size(), 3);
+    ASSERT_EQ(result.rowCount(), 3);
+    EXPECT_EQ(result.columns[0].integerAt(0), INT64_MIN);
+    EXPECT_LE(result.columns[0].integerAt(1), result.columns[0].integerAt(2));
+    EXPECT_EQ(result.columns[2].type(), DataType::VARCHAR);
+    
+    plan.outputs = {{2, "c", DataType::VARCHAR}, {0, "a", DataType::INTEGER}};
+    TableData projected = Sorter(plan).execute(data);
+    ASSERT_EQ(projected.columns.size(), 2);
+    EXPECT_EQ(projected.columns[0].type(), DataType::VARCHAR);
+    EXPECT_EQ(projected.columns[1].integerAt(0), INT64_MIN);
+    for (size_t row = 0; row < 3; ++row) {
+        EXPECT_EQ(projected.columns[0].stringAt(row), result.columns[2].stringAt(row));
+    }
+}
+
+TEST_F(SortTest, EdgeCases) {
+    EXPECT_TRUE(Sorter(makePlan({{0, DataType::INTEGER, false}}, 0)).sortedRows(data).empty());
+    EXPECT_EQ(Sorter(makePlan({}, 2)).sortedRows(data), (std::vector<size_t>{0, 1}));
+    
+    TableData empty(table);
+    EXPECT_TRUE(Sorter(makePlan({{2, DataType::VARCHAR, false}})).sortedRows(empty).empty());
+    EXPECT_EQ(Sorter(makePlan({{2, DataType::VARCHAR, false}}, 5)).execute(empty).rowCount(), 0);
+}
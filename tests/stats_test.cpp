@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "common/stats.h"
+#include "parser/lexer.h"
+#include "parser/parser.h"
+
+class StatsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Stats::instance().reset();
+    }
+};
+
+TEST_F(StatsTest, HistogramSmallValuesAreExact) {
+    for (uint64_t v = 0; v < LatencyHistogram::SUB_BUCKETS; ++v) {
+        EXPECT_EQ(LatencyHistogram::bucketIndex(v), v);
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(v), v);
+    }
+}
+
+TEST_F(StatsTest, HistogramBucketsBoundValues) {
+    const uint64_t values[] = {16, 17, 31, 32, 1000, 123456789, UINT64_MAX};
+    for (uint64_t v : values) {
+        size_t index = LatencyHistogram::bucketIndex(v);
+        ASSERT_LT(index, LatencyHistogram::NUM_BUCKETS);
+        uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+        EXPECT_GE(upper, v);
+        EXPECT_LE(upper - v, v / LatencyHistogram::SUB_BUCKETS);
+    }
+}
+
+TEST_F(StatsTest, HistogramPercentiles) {
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 1000; ++v) {
+        histogram.record(v);
+    }
+    
+    EXPECT_EQ(histogram.count(), 1000);
+    EXPECT_EQ(histogram.min(), 1);
+    EXPECT_EQ(histogram.max(), 1000);
+    EXPECT_EQ(histogram.sum(), 500500);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(50)), 500, 500 * 0.07);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(99)), 990, 990 * 0.07);
+    EXPECT_EQ(histogram.percentile(100), 1000);
+}
+
+TEST_F(StatsTest, EmptyHistogram) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.min(), 0);
+    EXPECT_EQ(histogram.percentile(99), 0);
+}
+
+#ifdef DB_ENABLE_STATS
+TEST_F(StatsTest, RecordsLexAndParsePhases) {
+    Lexer lexer("SELECT name, age FROM users WHERE age > 18");
+    auto tokens = lexer.tokenize();
+    Parser parser(tokens);
+    auto ast = parser.parse();
+    
+    const Stats& stats = Stats::instance();
+    EXPECT_EQ(stats.phase(Phase::LEX).latency.count(), 1);
+    EXPECT_EQ(stats.phase(Phase::PARSE).latency.count(), 1);
+    EXPECT_GT(stats.phase(Phase::LEX).bytes_allocated.load(), 0);
+    EXPECT_EQ(stats.counter(Counter::TOKENS), tokens.size());
+    EXPECT_EQ(stats.counter(Counter::AST_NODES), parser.nodeCount());
+    EXPECT_EQ(stats.counter(Counter::STATEMENTS), 1);
+}
+#else
+TEST_F(StatsTest, NothingIsRecordedWhenCompiledOut) {
+    Lexer lexer("SELECT name, age FROM users WHERE age > 18");
+    Parser parser(lexer.tokenize());
+    auto ast = parser.parse();
+    
+    const Stats& stats = Stats::instance();
+    EXPECT_EQ(stats.phase(Phase::LEX).latency.count(), 0);
+    EXPECT_EQ(stats.phase(Phase::PARSE).latency.count(), 0);
+    EXPECT_EQ(stats.counter(Counter::TOKENS), 0);
+    EXPECT_EQ(parser.nodeCount(), 0);
+    EXPECT_EQ(threadAllocationCount(), 0);
+}
+#endif
+
+TEST_F(StatsTest, JsonAndPrometheusOutput) {
+    Stats::instance().recordPhase(Phase::LEX, 1500, 64, 2);
+    Stats::instance().addCounter(Counter::TOKENS, 7);
+    
+    std::string json = Stats::instance().toJson();
+    EXPECT_NE(json.find("\"lex\":{\"calls\":1,\"total_ns\":1500,\"bytes_allocated\":64"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"tokens\":7"), std::string::npos);
+    
+    std::string prom = Stats::instance().toPrometheus();
+    EXPECT_NE(prom.find("db_phase_latency_nanoseconds_count{phase=\"lex\"} 1"),
+              std::string::npos);
+    EXPECT_NE(prom.find("db_phase_allocated_bytes_total{phase=\"lex\"} 64"),
+              std::string::npos);
+    EXPECT_NE(prom.find("db_tokens_total 7"), std::string::npos);
+}
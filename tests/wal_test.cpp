@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "parser/lexer.h"
+#include "parser/parser.h"
+#include "storage/insert_batch.h"
+#include "storage/wal.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class WalTest : public ::testing::Test {
+protected:
+    TableInfo table{"users", 3};
+    std::string path;
+    std::vector<std::unique_ptr<Statement>> statements;
+
+    void SetUp() override {
+        table.addColumn(ColumnInfo("id", DataType::INTEGER, 0));
+        table.addColumn(ColumnInfo("name", DataType::VARCHAR, 1));
+        table.addColumn(ColumnInfo("score", DataType::FLOAT, 2));
+        table.addColumn(ColumnInfo("active", DataType::BOOLEAN, 3));
+        table.addColumn(ColumnInfo("joined", DataType::DATE, 4));
+        path = (std::filesystem::temp_directory_path() /
+                ("wal_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" +
+                 ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".log")).string();
+        std::filesystem::remove(path);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    const InsertStatement* parseInsert(const std::string& sql) {
+        Lexer lexer(sql);
+        Parser parser(lexer.tokenize());
+        statements.push_back(parser.parse());
+        return dynamic_cast<const InsertStatement*>(statements.back().get());
+    }
+
+    TableData row(int id) {
+        return buildInsertBatch(table, {parseInsert(
+            "INSERT INTO users VALUES (" + std::to_string(id) + ", 'user" + std::to_string(id) +
+            "', 1.5, 1, '2024-01-01')")});
+    }
+
+    std::vector<int64_t> replayIds() {
+        std::vector<int64_t> ids;
+        WriteAheadLog::replay(path, [&](size_t table_id, TableData&& rows) {
+            EXPECT_EQ(table_id, 3);
+            for (int64_t id : rows.columns[0].integers()) ids.push_back(id);
+        });
+        return ids;
+    }
+
+    void appendBytes(const std::string& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << bytes;
+    }
+};
+
+TEST_F(WalTest, BuildInsertBatch) {
+    TableData rows = buildInsertBatch(table, {
+        parseInsert("INSERT INTO users VALUES (1, 'Ann', 2.5, 'true', '1970-01-11')"),
+        parseInsert("INSERT INTO Users (joined, active, score, name, id) VALUES ('1969-12-31', 0, 3, 'Bo', 2)"),
+    });
+    
+    ASSERT_EQ(rows.rowCount(), 2);
+    EXPECT_EQ(rows.columns[0].integers(), (std::vector<int64_t>{1, 2}));
+    EXPECT_EQ(rows.columns[1].strings(), (std::vector<std::string>{"Ann", "Bo"}));
+    EXPECT_EQ(rows.columns[2].floats(), (std::vector<double>{2.5, 3.0}));
+    EXPECT_EQ(rows.columns[3].integers(), (std::vector<int64_t>{1, 0}));
+    EXPECT_EQ(rows.columns[4].integers(), (std::vector<int64_t>{10, -1}));
+    
+    auto fails = [&](const std::string& sql) {
+        EXPECT_THROW(buildInsertBatch(table, {parseInsert(sql)}), std::runtime_error) << sql;
+    };
+    fails("INSERT INTO other VALUES (1, 'a', 1, 1, '2024-01-01')");
+    fails("INSERT INTO users VALUES (1, 'a', 1, 1)");
+    fails("INSERT INTO users VALUES ('1', 'a', 1, 1, '2024-01-01')");
+    fails("INSERT INTO users VALUES (1.5, 'a', 1, 1, '2024-01-01')");
+    fails("INSERT INTO users VALUES (1, 'a', 1, 1, '2024-13-01')");
+    fails("INSERT INTO users (id, name) VALUES (1, 'a')");
+    fails("INSERT INTO users (id, id, score, active, joined) VALUES (1, 2, 1, 1, '2024-01-01')");
+    fails("INSERT INTO users (id, nope, score, active, joined) VALUES (1, 'a', 1, 1, '2024-01-01')");
+}
+
+TEST_F(WalTest, ReplaysRecordsInOrder) {
+    {
+        WriteAheadLog wal(path);
+        EXPECT_EQ(wal.append(3, row(1)), 1);
+        EXPECT_EQ(wal.append(3, row(2)), 2);
+        EXPECT_EQ(wal.durableLsn(), 2);
+    }
+    
+    std::vector<TableData> replayed;
+    size_t records = WriteAheadLog::replay(path, [&](size_t table_id, TableData&& rows) {
+        EXPECT_EQ(table_id, 3);
+        replayed.push_back(std::move(rows));
+    });
+    ASSERT_EQ(records, 2);
+    EXPECT_EQ(replayed[1].columns[1].strings(), (std::vector<std::string>{"user2"}));
+    EXPECT_EQ(replayed[1].columns[2].type(), DataType::FLOAT);
+    EXPECT_EQ(replayed[1].columns[4].integers(), (std::vector<int64_t>{19723}));
+    
+    // Reopening continues the sequence.
+    WriteAheadLog wal(path);
+    EXPECT_EQ(wal.durableLsn(), 2);
+    EXPECT_EQ(wal.append(3, row(3)), 3);
+    EXPECT_EQ(WriteAheadLog::replay(path, [](size_t, TableData&&) {}), 3);
+    EXPECT_EQ(WriteAheadLog::replay(path + ".missing", [](size_t, TableData&&) {}), 0);
+}
+
+TEST_F(WalTest, ConcurrentWritersShareCommits) {
+    constexpr int WRITERS = 8;
+    constexpr int PER_WRITER = 50;
+    TableData one = row(0);
+    WalOptions options;
+    options.max_commit_delay = std::chrono::milliseconds(2);
+    options.max_batch_records = WRITERS;
+    {
+        WriteAheadLog wal(path, options);
+        std::vector<std::thread> threads;
+        for (int w = 0; w < WRITERS; ++w) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < PER_WRITER; ++i) wal.append(3, one);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        EXPECT_EQ(wal.durableLsn(), WRITERS * PER_WRITER);
+        EXPECT_LT(wal.commitCount(), WRITERS * PER_WRITER);
+    }
+    EXPECT_EQ(replayIds().size(), WRITERS * PER_WRITER);
+}
+
+TEST_F(WalTest, RecoveryStopsAtTornOrCorruptTail) {
+    {
+        WriteAheadLog wal(path);
+        for (int id = 1; id <= 3; ++id) wal.append(3, row(id));
+    }
+    const auto intact_size = std::filesystem::file_size(path);
+    
+    // A torn header, then a torn record.
+    appendBytes(std::string("\x10\x00", 2));
+    EXPECT_EQ(replayIds(), (std::vector<int64_t>{1, 2, 3}));
+    std::filesystem::resize_file(path, intact_size);
+    appendBytes(std::string("\x40\x00\x00\x00\x00\x00\x00\x00", 8) + std::string(20, 'x'));
+    EXPECT_EQ(replayIds(), (std::vector<int64_t>{1, 2, 3}));
+    
+    // Reopening drops the tail so new records stay reachable.
+    {
+        WriteAheadLog wal(path);
+        EXPECT_EQ(std::filesystem::file_size(path), intact_size);
+        EXPECT_EQ(wal.append(3, row(4)), 4);
+    }
+    EXPECT_EQ(replayIds(), (std::vector<int64_t>{1, 2, 3, 4}));
+    
+    // A flipped payload byte fails the checksum of that record and hides the rest.
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(intact_size / 3 + 20));
+        file.put('\x7f');
+    }
+    EXPECT_EQ(replayIds(), (std::vector<int64_t>{1}));
+}
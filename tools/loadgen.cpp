@@ -0,0 +1,165 @@
+// Closed-loop load generator for `database --server`. Each connection sends
+// a window of pipelined requests, waits for all responses, and repeats.
+// Reports throughput and per-request latency percentiles.
+
+#include "common/stats.h"
+#include "server/protocol.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct LoadConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = 5433;
+    std::string unix_socket_path;
+    size_t connections = 4;
+    size_t pipeline = 16;
+    double duration_seconds = 5.0;
+    std::string query = "SELECT name, age FROM users WHERE age > 18 AND balance > 1000.0";
+};
+
+int connectTo(const LoadConfig& config) {
+    int fd;
+    if (!config.unix_socket_path.empty()) {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, config.unix_socket_path.c_str(), sizeof(addr.sun_path) - 1);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            throw std::runtime_error("Cannot connect to " + config.unix_socket_path);
+        }
+        return fd;
+    }
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config.port);
+    inet_pton(AF_INET, config.host.c_str(), &addr.sin_addr);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        throw std::runtime_error("Cannot connect to " + config.host + ":" + std::to_string(config.port));
+    }
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    return fd;
+}
+
+void sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            throw std::runtime_error("send failed");
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+void runConnection(const LoadConfig& config, LatencyHistogram& latency,
+                   std::atomic<uint64_t>& errors,
+                   std::chrono::steady_clock::time_point deadline) {
+    int fd = connectTo(config);
+    std::string window;
+    for (size_t i = 0; i < config.pipeline; ++i) {
+        appendFrame(window, config.query);
+    }
+    
+    std::string buffer;
+    char chunk[64 * 1024];
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto start = std::chrono::steady_clock::now();
+        sendAll(fd, window);
+        
+        size_t received = 0;
+        size_t offset = 0;
+        std::string payload;
+        while (received < config.pipeline) {
+            if (readFrame(buffer, offset, payload)) {
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                latency.record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+                if (payload.empty() || payload[0] != static_cast<char>(ResponseStatus::OK)) {
+                    errors++;
+                }
+                received++;
+                continue;
+            }
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                close(fd);
+                throw std::runtime_error("Server closed the connection");
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+        buffer.erase(0, offset);
+    }
+    close(fd);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LoadConfig config;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string value = argv[i + 1];
+        if (arg == "--host") config.host = value;
+        else if (arg == "--port") config.port = static_cast<uint16_t>(std::stoi(value));
+        else if (arg == "--unix") config.unix_socket_path = value;
+        else if (arg == "--connections") config.connections = std::stoul(value);
+        else if (arg == "--pipeline") config.pipeline = std::stoul(value);
+        else if (arg == "--duration") config.duration_seconds = std::stod(value);
+        else if (arg == "--query") config.query = value;
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+    
+    LatencyHistogram latency;
+    std::atomic<uint64_t> errors{0};
+    std::atomic<bool> failed{false};
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(config.duration_seconds));
+    
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < config.connections; ++i) {
+        threads.emplace_back([&] {
+            try {
+                runConnection(config, latency, errors, deadline);
+            } catch (const std::exception& e) {
+                std::cerr << "Connection error: " << e.what() << "\n";
+                failed = true;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << "connections=" << config.connections
+              << " pipeline=" << config.pipeline
+              << " requests=" << latency.count()
+              << " errors=" << errors.load() << "\n";
+    std::cout << "qps=" << static_cast<uint64_t>(static_cast<double>(latency.count()) / elapsed) << "\n";
+    std::cout << "latency_us p50=" << latency.percentile(50) / 1000.0
+              << " p99=" << latency.percentile(99) / 1000.0
+              << " p99.9=" << latency.percentile(99.9) / 1000.0
+              << " max=" << latency.max() / 1000.0 << "\n";
+    return failed ? 1 : 0;
+}